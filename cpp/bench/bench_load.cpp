@@ -0,0 +1,129 @@
+// ЗАМЕР СКОРОСТИ ЗАГРУЗКИ ТЕКСТОВЫХ ФАЙЛОВ ДАННЫХ
+// Генерирует grades.txt и submissions.txt во временном каталоге и сравнивает
+// разбор через MappedFile/string_view (DataManager::loadGrades, loadSubmissions)
+// с прежним способом: getline в string, stringstream, stoi/stod.
+// Запуск: bench_load [число строк], по умолчанию 1000000
+#include "../data_manager.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <iomanip>
+
+using namespace std;
+
+namespace {
+
+// Прежний разбор grades.txt: строка, поток и исключения на каждое поле
+vector<DataGrade> loadGradesStream(const string& path) {
+    vector<DataGrade> grades;
+    ifstream file(path);
+    string line;
+    while (getline(file, line)) {
+        stringstream ss(line);
+        DataGrade grade;
+        string studentIdStr, scoreStr, timestampStr;
+        if (getline(ss, studentIdStr, ',') &&
+            getline(ss, grade.subjectName, ',') &&
+            getline(ss, grade.assignmentName, ',') &&
+            getline(ss, scoreStr, ',') &&
+            getline(ss, grade.type, ',') &&
+            getline(ss, timestampStr, ',')) {
+            grade.studentId = stoi(studentIdStr);
+            grade.score = stod(scoreStr);
+            grade.timestamp = stoll(timestampStr);
+            grades.push_back(grade);
+        }
+    }
+    return grades;
+}
+
+// Прежний разбор submissions.txt
+vector<DataSubmission> loadSubmissionsStream(const string& path) {
+    vector<DataSubmission> submissions;
+    ifstream file(path);
+    string line;
+    while (getline(file, line)) {
+        stringstream ss(line);
+        DataSubmission submission;
+        string studentIdStr, timestampStr;
+        if (getline(ss, studentIdStr, ',') &&
+            getline(ss, submission.subjectName, ',') &&
+            getline(ss, submission.assignmentName, ',') &&
+            getline(ss, submission.status, ',') &&
+            getline(ss, timestampStr, ',') &&
+            getline(ss, submission.type, ',')) {
+            submission.studentId = stoi(studentIdStr);
+            submission.timestamp = stoll(timestampStr);
+            submissions.push_back(submission);
+        }
+    }
+    return submissions;
+}
+
+// Лучшее время из нескольких прогонов, в секундах
+double bestOf(int runs, const function<size_t()>& load, size_t& rows) {
+    double best = 1e300;
+    for (int i = 0; i < runs; i++) {
+        auto start = chrono::steady_clock::now();
+        rows = load();
+        best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+void report(const string& name, size_t rows, double seconds) {
+    cout << "  " << left << setw(28) << name << right << setw(10) << rows << " строк  "
+         << fixed << setprecision(1) << setw(8) << seconds * 1000 << " мс  "
+         << setprecision(2) << setw(7) << rows / seconds / 1e6 << " млн строк/с\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? stoul(argv[1]) : 1000000;
+    
+    // DataManager работает с каталогом data/ относительно текущего
+    filesystem::path workDir = filesystem::temp_directory_path() / "lab5_bench_load";
+    filesystem::create_directories(workDir / "data");
+    filesystem::current_path(workDir);
+    
+    mt19937 random(42);
+    {
+        ofstream grades("data/grades.txt");
+        ofstream submissions("data/submissions.txt");
+        for (size_t i = 0; i < count; i++) {
+            int studentId = random() % 20000 + 1;
+            string subject = "Subject" + to_string(random() % 50);
+            string item = "Assignment" + to_string(random() % 30);
+            long long timestamp = 1700000000 + random() % 10000000;
+            grades << studentId << "," << subject << "," << item << ","
+                   << (random() % 1000) / 10.0 << ",assignment," << timestamp << "\n";
+            submissions << studentId << "," << subject << "," << item << ",approved,"
+                        << timestamp << ",assignment\n";
+        }
+    }
+    
+    const int runs = 3;
+    size_t rows = 0;
+    double seconds;
+    cout << "Файлы по " << count << " строк, лучший из " << runs << " прогонов\n";
+    cout << "grades.txt:\n";
+    seconds = bestOf(runs, [] { return loadGradesStream("data/grades.txt").size(); }, rows);
+    report("getline + stringstream", rows, seconds);
+    seconds = bestOf(runs, [] { return DataManager::loadGrades().size(); }, rows);
+    report("mmap + string_view", rows, seconds);
+    cout << "submissions.txt:\n";
+    seconds = bestOf(runs, [] { return loadSubmissionsStream("data/submissions.txt").size(); }, rows);
+    report("getline + stringstream", rows, seconds);
+    seconds = bestOf(runs, [] { return DataManager::loadSubmissions().size(); }, rows);
+    report("mmap + string_view", rows, seconds);
+    
+    filesystem::current_path(workDir.parent_path());
+    filesystem::remove_all(workDir);
+    return 0;
+}
+//g++ -std=c++17 -O2 -pthread -o bench_load bench/bench_load.cpp data_manager.cpp gradebook.cpp journal_writer.cpp leaderboard.cpp mapped_file.cpp object.cpp professor.cpp rw_lock.cpp score_kernels.cpp score_ranking.cpp student.cpp symbol_table.cpp user.cpp notification_queue.cpp
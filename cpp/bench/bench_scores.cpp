@@ -0,0 +1,139 @@
+// ЗАМЕР СКОРОСТИ СВОДОК ПО ОЦЕНКАМ
+// Сравнивает прежний обход map<int, map<string, double>> (как в generateFinalReport
+// и статистике предмета до Gradebook) с векторными ядрами по плотному журналу:
+// Gradebook::summarizeAll и Gradebook::histogram.
+// Запуск: bench_scores [число оценок ...], по умолчанию 10000 и 1000000
+#include "../gradebook.h"
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <iomanip>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+const size_t ITEMS = 20;       // Заданий в предмете
+const size_t BUCKETS = 10;     // Корзин гистограммы на [0, 100]
+
+// Прежний подсчет: проход по узлам дерева студентов и дерева заданий
+ScoreSummary summarizeMap(const map<int, map<string, double>>& grades) {
+    ScoreSummary summary;
+    for (const auto& [studentId, studentGrades] : grades) {
+        for (const auto& [item, grade] : studentGrades) {
+            if (summary.count == 0 || grade < summary.min) summary.min = grade;
+            if (summary.count == 0 || grade > summary.max) summary.max = grade;
+            summary.count++;
+            summary.sum += grade;
+            summary.sumSquares += grade * grade;
+        }
+    }
+    return summary;
+}
+
+void histogramMap(const map<int, map<string, double>>& grades, vector<size_t>& buckets) {
+    double width = 100.0 / buckets.size();
+    for (const auto& [studentId, studentGrades] : grades) {
+        for (const auto& [item, grade] : studentGrades) {
+            long bucket = static_cast<long>(grade / width);
+            bucket = max(0L, min<long>(bucket, buckets.size() - 1));
+            buckets[bucket]++;
+        }
+    }
+}
+
+// Лучшее время одного прогона из нескольких серий, в секундах
+double bestOf(int runs, int repeats, const function<void()>& body) {
+    double best = 1e300;
+    for (int i = 0; i < runs; i++) {
+        auto start = chrono::steady_clock::now();
+        for (int j = 0; j < repeats; j++) {
+            body();
+        }
+        best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count() / repeats);
+    }
+    return best;
+}
+
+void report(const string& name, size_t grades, double seconds, double baseline) {
+    // Название в конце строки: кириллица занимает по два байта, и setw не выровняет ее
+    cout << fixed << setprecision(3) << setw(10) << seconds * 1000 << " мс  "
+         << setprecision(1) << setw(7) << grades / seconds / 1e6 << " млн оценок/с  x"
+         << setw(5) << left << baseline / seconds << right << "  " << name << "\n";
+}
+
+void run(size_t count) {
+    // Оценки распределены по студентам по ITEMS заданий; часть ячеек пустая, как в реальном журнале
+    size_t students = 0;
+    mt19937 random(42);
+    vector<Symbol> items;
+    for (size_t i = 0; i < ITEMS; i++) {
+        items.push_back(SymbolTable::intern("Assignment" + to_string(i)));
+    }
+
+    map<int, map<string, double>> grades;
+    Gradebook gradebook;
+    size_t placed = 0;
+    for (; placed < count; students++) {
+        for (size_t i = 0; i < ITEMS && placed < count; i++) {
+            if (random() % 10 == 0) {
+                continue;
+            }
+            // Оценки хранятся во float, поэтому и в дереве - то же значение
+            double grade = static_cast<float>((random() % 1001) / 10.0);
+            grades[students + 1][SymbolTable::name(items[i])] = grade;
+            gradebook.setGrade(students + 1, items[i], grade);
+            placed++;
+        }
+    }
+
+    // Серии подобраны так, чтобы малый набор считался не меньше десятков миллисекунд
+    int repeats = max<int>(1, 2000000 / max<size_t>(placed, 1));
+    const int runs = 5;
+    ScoreSummary expected = summarizeMap(grades);
+    ScoreSummary actual = gradebook.summarizeAll();
+    if (expected.count != actual.count || fabs(expected.sum - actual.sum) > 1e-6 * fabs(expected.sum)) {
+        cout << "Сводки не совпадают: " << expected.count << " / " << actual.count << "\n";
+    }
+
+    cout << placed << " оценок (" << students << " студентов x " << ITEMS << " заданий), ядро "
+         << scoreKernelName() << ", лучший из " << runs << " прогонов\n";
+
+    volatile double sink = 0;
+    double base = bestOf(runs, repeats, [&] { sink = sink + summarizeMap(grades).variance(); });
+    report("сводка: map<int, map<string>>", placed, base, base);
+    double kernel = bestOf(runs, repeats, [&] { sink = sink + gradebook.summarizeAll().variance(); });
+    report("сводка: Gradebook::summarizeAll", placed, kernel, base);
+
+    base = bestOf(runs, repeats, [&] {
+        vector<size_t> buckets(BUCKETS, 0);
+        histogramMap(grades, buckets);
+        sink = sink + buckets[0];
+    });
+    report("гистограмма: map<int, map<string>>", placed, base, base);
+    kernel = bestOf(runs, repeats, [&] {
+        vector<size_t> buckets(BUCKETS, 0);
+        gradebook.histogram(0.0, 100.0, buckets);
+        sink = sink + buckets[0];
+    });
+    report("гистограмма: Gradebook::histogram", placed, kernel, base);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    vector<size_t> counts;
+    for (int i = 1; i < argc; i++) {
+        counts.push_back(stoul(argv[i]));
+    }
+    if (counts.empty()) {
+        counts = {10000, 1000000};
+    }
+    for (size_t count : counts) {
+        run(count);
+    }
+    return 0;
+}
+//g++ -std=c++17 -O2 -pthread -o bench_scores bench/bench_scores.cpp gradebook.cpp rw_lock.cpp score_kernels.cpp symbol_table.cpp
@@ -3,29 +3,155 @@
 #include "student.h"
 #include "professor.h"
 #include "object.h"
+#include "mapped_file.h"
+#include "journal_writer.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <ctime>
 #include <filesystem>
 #include <algorithm>
+#include <unordered_map>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define HAS_FSYNC 1
+#endif
 
 using namespace std;
 
 const string DataManager::DATA_DIR = "data";
+bool DataManager::journalMode = true;
+long long DataManager::journalSeq = 0;
+int DataManager::journalSize = 0;
+bool DataManager::binarySnapshot = false;
+unique_ptr<JournalWriter> DataManager::journalWriter;
+vector<string> DataManager::stagedFiles;
+bool DataManager::stagingFailed = false;
+
+namespace {
+
+// Сбросить файл или каталог на диск (каталог - чтобы сохранились переименования)
+bool syncPath(const string& path) {
+#ifdef HAS_FSYNC
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+#else
+    (void)path;
+    return true;
+#endif
+}
+
+}
 
 void DataManager::initDataDirectory() {
     filesystem::create_directory(DATA_DIR);
 }
 
-void DataManager::saveNextUserId(int nextId) {
-    ofstream file(DATA_DIR + "/next_id.txt");
-    if (file.is_open()) {
-        file << nextId;
-        file.close();
+string DataManager::stagingPath(const string& fileName) {
+    stagedFiles.push_back(fileName);
+    return DATA_DIR + "/" + fileName + ".tmp";
+}
+
+void DataManager::stage(const string& fileName, ofstream& file) {
+    file.close();
+    if (file.fail()) {
+        cout << "Ошибка: не удалось записать " << fileName << "\n";
+        stagingFailed = true;
     }
 }
 
+bool DataManager::commitStaged(const vector<string>& removed) {
+    error_code error;
+    bool ok = !stagingFailed;
+    for (const auto& fileName : stagedFiles) {
+        ok = ok && syncPath(DATA_DIR + "/" + fileName + ".tmp");
+    }
+    
+    // Манифест: как только он переименован в commit.txt, новый набор файлов считается
+    // записанным, и прерванная подмена довершается при следующем запуске
+    if (ok) {
+        ofstream manifest(DATA_DIR + "/commit.txt.tmp", ios::trunc);
+        for (const auto& fileName : stagedFiles) {
+            manifest << fileName << "\n";
+        }
+        for (const auto& fileName : removed) {
+            manifest << "-" << fileName << "\n";
+        }
+        manifest.close();
+        ok = !manifest.fail() && syncPath(DATA_DIR + "/commit.txt.tmp");
+    }
+    if (ok) {
+        filesystem::rename(DATA_DIR + "/commit.txt.tmp", DATA_DIR + "/commit.txt", error);
+        ok = !error && syncPath(DATA_DIR);
+    }
+    
+    if (!ok) {
+        cout << "Ошибка: данные не сохранены, прежние файлы не изменены\n";
+        for (const auto& fileName : stagedFiles) {
+            filesystem::remove(DATA_DIR + "/" + fileName + ".tmp", error);
+        }
+        filesystem::remove(DATA_DIR + "/commit.txt.tmp", error);
+    }
+    stagedFiles.clear();
+    stagingFailed = false;
+    if (ok) {
+        applyCommit();
+    }
+    return ok;
+}
+
+void DataManager::applyCommit() {
+    error_code error;
+    ifstream manifest(DATA_DIR + "/commit.txt");
+    string fileName;
+    while (getline(manifest, fileName)) {
+        if (fileName.empty()) {
+            continue;
+        }
+        if (fileName[0] == '-') {
+            filesystem::remove(DATA_DIR + "/" + fileName.substr(1), error);
+        } else if (filesystem::exists(DATA_DIR + "/" + fileName + ".tmp")) {
+            // Файл без .tmp уже подменен до сбоя
+            filesystem::rename(DATA_DIR + "/" + fileName + ".tmp", DATA_DIR + "/" + fileName, error);
+        }
+    }
+    manifest.close();
+    syncPath(DATA_DIR);
+    filesystem::remove(DATA_DIR + "/commit.txt", error);
+}
+
+void DataManager::recoverCheckpoint() {
+    error_code error;
+    if (filesystem::exists(DATA_DIR + "/commit.txt")) {
+        applyCommit();
+    }
+    // Временные файлы без манифеста - недописанная фиксация, действуют старые файлы и журнал
+    vector<filesystem::path> leftovers;
+    for (const auto& entry : filesystem::directory_iterator(DATA_DIR, error)) {
+        if (entry.path().extension() == ".tmp") {
+            leftovers.push_back(entry.path());
+        }
+    }
+    for (const auto& path : leftovers) {
+        filesystem::remove(path, error);
+    }
+}
+
+void DataManager::saveNextUserId(int nextId) {
+    ofstream file(stagingPath("next_id.txt"));
+    file << nextId;
+    stage("next_id.txt", file);
+}
+
 int DataManager::loadNextUserId() {
     ifstream file(DATA_DIR + "/next_id.txt");
     if (file.is_open()) {
@@ -38,38 +164,26 @@ int DataManager::loadNextUserId() {
 }
 
 void DataManager::saveUsers(const map<string, shared_ptr<User>>& users) {
-    ofstream file(DATA_DIR + "/users.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+    ofstream file(stagingPath("users.txt"));
     for (const auto& [name, user] : users) {
         file << user->getId() << "," << name << "," 
              << user->getPasswordHash() << "," 
              << static_cast<int>(user->getRole()) << "\n";
     }
-    file.close();
+    stage("users.txt", file);
 }
 
 void DataManager::saveSubjects(const vector<shared_ptr<Subject>>& subjects) {
-    ofstream file(DATA_DIR + "/subjects.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+    ofstream file(stagingPath("subjects.txt"));
     for (const auto& subject : subjects) {
         file << subject->getName() << "," << subject->getCode() << "," 
              << subject->getProfessorId() << "\n";
     }
-    file.close();
+    stage("subjects.txt", file);
 }
 
 void DataManager::saveSubjectGrades(const vector<shared_ptr<Subject>>& subjects) {
-    ofstream file(DATA_DIR + "/subject_grades.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+    ofstream file(stagingPath("subject_grades.txt"));
     for (const auto& subject : subjects) {
         string subjectName = subject->getName();
         if (subjectName.empty()) continue;
@@ -92,29 +206,21 @@ void DataManager::saveSubjectGrades(const vector<shared_ptr<Subject>>& subjects)
             }
         }
     }
-    file.close();
+    stage("subject_grades.txt", file);
 }
 
 void DataManager::saveAssignments(const vector<shared_ptr<Assignment>>& assignments) {
-    ofstream file(DATA_DIR + "/assignments.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+    ofstream file(stagingPath("assignments.txt"));
     for (const auto& assignment : assignments) {
         file << assignment->getName() << "," 
              << "" << "," 
              << assignment->getMaxScore() << "," << assignment->getSubjectName() << "\n";
     }
-    file.close();
+    stage("assignments.txt", file);
 }
 
 void DataManager::saveReports(const vector<shared_ptr<Report>>& reports) {
-    ofstream file(DATA_DIR + "/reports.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+    ofstream file(stagingPath("reports.txt"));
     for (const auto& report : reports) {
         file << report->getTopic() << "," << report->getSubjectName() << ","
              << report->getMaxParticipants() << "," 
@@ -126,15 +232,11 @@ void DataManager::saveReports(const vector<shared_ptr<Report>>& reports) {
         }
         file << "\n";
     }
-    file.close();
+    stage("reports.txt", file);
 }
 
-void DataManager::saveEnrollments(const map<int, vector<string>>& studentEnrollments) {
-    ofstream file(DATA_DIR + "/enrollments.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+void DataManager::saveEnrollments(const map<int, set<string>>& studentEnrollments) {
+    ofstream file(stagingPath("enrollments.txt"));
     for (const auto& [studentId, subjects] : studentEnrollments) {
         file << studentId;
         for (const auto& subject : subjects) {
@@ -142,309 +244,751 @@ void DataManager::saveEnrollments(const map<int, vector<string>>& studentEnrollm
         }
         file << "\n";
     }
-    file.close();
+    stage("enrollments.txt", file);
 }
 
 void DataManager::saveSubmissions(const vector<DataSubmission>& submissions) {
-    ofstream file(DATA_DIR + "/submissions.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+    ofstream file(stagingPath("submissions.txt"));
     for (const auto& submission : submissions) {
         file << submission.studentId << "," << submission.subjectName << ","
              << submission.assignmentName << "," << submission.status << ","
-             << submission.timestamp << "\n";
+             << submission.timestamp << "," << submission.type << "\n";
     }
-    file.close();
+    stage("submissions.txt", file);
 }
 
 void DataManager::saveGrades(const vector<DataGrade>& grades) {
-    ofstream file(DATA_DIR + "/grades.txt");
-    if (!file.is_open()) {
-        return;
-    }
-    
+    ofstream file(stagingPath("grades.txt"));
     for (const auto& grade : grades) {
         file << grade.studentId << "," << grade.subjectName << ","
              << grade.assignmentName << "," << grade.score << ","
              << grade.type << "," << grade.timestamp << "\n";
     }
-    file.close();
+    stage("grades.txt", file);
 }
 
-void DataManager::saveAllData(const map<string, shared_ptr<User>>& users,
+bool DataManager::saveAllData(const map<string, shared_ptr<User>>& users,
                              const vector<shared_ptr<Subject>>& subjects,
                              const vector<shared_ptr<Assignment>>& assignments,
                              const vector<shared_ptr<Report>>& reports,
-                             const map<int, vector<string>>& studentEnrollments,
+                             const map<int, set<string>>& studentEnrollments,
                              const vector<DataSubmission>& submissions,
-                             const vector<DataGrade>& grades) {
+                             const vector<DataGrade>& grades,
+                             unsigned collections) {
     initDataDirectory();
     
-    saveUsers(users);
-    saveSubjects(subjects);
-    saveAssignments(assignments);
-    saveReports(reports);
-    saveEnrollments(studentEnrollments);
-    saveSubmissions(submissions);
-    saveGrades(grades);
-    saveSubjectGrades(subjects);
-    saveNextUserId(User::getNextId());
+    vector<string> removed;
+    if (collections & DATA_USERS) saveUsers(users);
+    if (collections & DATA_SUBJECTS) saveSubjects(subjects);
+    if (collections & DATA_ASSIGNMENTS) saveAssignments(assignments);
+    if (collections & DATA_REPORTS) saveReports(reports);
+    if (collections & DATA_ENROLLMENTS) saveEnrollments(studentEnrollments);
+    if (binarySnapshot) {
+        if (collections & (DATA_SUBMISSIONS | DATA_GRADES)) {
+            saveSnapshot(submissions, grades);
+        }
+    } else if (collections & (DATA_SUBMISSIONS | DATA_GRADES)) {
+        if (collections & DATA_SUBMISSIONS) saveSubmissions(submissions);
+        if (collections & DATA_GRADES) saveGrades(grades);
+        removed.push_back("snapshot.bin");
+    }
+    if (collections & DATA_SUBJECT_GRADES) saveSubjectGrades(subjects);
+    if (collections & DATA_NEXT_ID) saveNextUserId(User::getNextId());
+    
+    // Контрольная точка: все записи журнала до journalSeq уже отражены в файлах выше.
+    // Она фиксируется вместе с ними, поэтому после сбоя журнал не повторяется поверх
+    // файлов, которые уже содержат его записи
+    bool journalDurable = waitForJournal();
+    ofstream checkpoint(stagingPath("checkpoint.txt"));
+    checkpoint << journalSeq;
+    stage("checkpoint.txt", checkpoint);
+    if (!commitStaged(removed)) {
+        return false;
+    }
+    // Недописанные из-за ошибки записи журнала сохранены самой контрольной точкой
+    if (!journalDurable) {
+        journalWriter->discardPending();
+    }
+    
+    ofstream journal(DATA_DIR + "/journal.log", ios::trunc);
+    journal.close();
+    journalSize = 0;
+    return true;
+}
+
+void DataManager::appendJournal(const string& type, const vector<string>& fields) {
+    string line = to_string(++journalSeq) + "," + type;
+    for (const auto& field : fields) {
+        line += ",";
+        line += field;
+    }
+    line += "\n";
+    journalSize++;
+    
+    if (journalWriter) {
+        journalWriter->enqueue(journalSeq, line);
+        return;
+    }
+    
+    // Без фонового потока запись сохраняется на диск до возврата
+    if (!JournalWriter::writeDurably(DATA_DIR + "/journal.log", line)) {
+        cout << "Ошибка: не удалось записать журнал изменений\n";
+    }
+}
+
+void DataManager::startJournalWriter(int windowMs) {
+    stopJournalWriter();
+    // Записи до journalSeq уже в журнале (или в контрольной точке): ждать их не нужно
+    journalWriter = make_unique<JournalWriter>(DATA_DIR + "/journal.log", chrono::milliseconds(windowMs), journalSeq);
+}
+
+void DataManager::stopJournalWriter() {
+    journalWriter.reset();
+}
+
+bool DataManager::waitForJournal() {
+    return !journalWriter || journalWriter->waitUntilDurable(journalSeq);
+}
+
+vector<JournalRecord> DataManager::loadJournal() {
+    vector<JournalRecord> records;
+    
+    long long checkpointSeq = 0;
+    ifstream checkpoint(DATA_DIR + "/checkpoint.txt");
+    if (checkpoint.is_open()) {
+        checkpoint >> checkpointSeq;
+        checkpoint.close();
+    }
+    journalSeq = checkpointSeq;
+    journalSize = 0;
+    
+    MappedFile file(DATA_DIR + "/journal.log");
+    if (!file.isOpen()) {
+        return records;
+    }
+    
+    // Строка без перевода строки в конце файла - недописанная запись, пропускаем
+    string_view contents = file.getContents();
+    contents = contents.substr(0, contents.rfind('\n') + 1);
+    
+    LineReader reader(contents);
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
+        
+        JournalRecord record;
+        if (fields.size() < 2 || !parseInt(fields[0], record.seq)) {
+            reportMalformedLine("journal.log", reader.getLineNumber());
+            continue;
+        }
+        if (record.seq <= checkpointSeq) {
+            continue;
+        }
+        
+        record.type = string(fields[1]);
+        record.fields.assign(fields.begin() + 2, fields.end());
+        record.lineNumber = reader.getLineNumber();
+        
+        journalSeq = max(journalSeq, record.seq);
+        journalSize++;
+        records.push_back(record);
+    }
+    return records;
+}
+
+void DataManager::reportMalformedLine(const string& fileName, size_t lineNumber) {
+    cout << "Предупреждение: пропущена некорректная строка " << lineNumber
+         << " в файле " << fileName << "\n";
 }
 
 map<string, shared_ptr<User>> DataManager::loadUsers() {
     map<string, shared_ptr<User>> users;
-    ifstream file(DATA_DIR + "/users.txt");
-    if (!file.is_open()) {
+    MappedFile file(DATA_DIR + "/users.txt");
+    if (!file.isOpen()) {
         return users;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string idStr, name, passwordHash, roleStr;
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
         
-        if (getline(ss, idStr, ',') &&
-            getline(ss, name, ',') &&
-            getline(ss, passwordHash, ',') &&
-            getline(ss, roleStr, ',')) {
-            
-            int id = stoi(idStr);
-            User::Role role = static_cast<User::Role>(stoi(roleStr));
-            
-            shared_ptr<User> user;
-            switch (role) {
-                case User::Role::STUDENT:
-                    user = make_shared<Student>(name, passwordHash, id);
-                    break;
-                case User::Role::PROFESSOR:
-                    user = make_shared<Professor>(name, passwordHash, id);
-                    break;
-            }
-            
-            if (user) {
-                users[name] = user;
-            }
+        int id, roleValue;
+        if (fields.size() < 4 || !parseInt(fields[0], id) || !parseInt(fields[3], roleValue)) {
+            reportMalformedLine("users.txt", reader.getLineNumber());
+            continue;
+        }
+        
+        string name(fields[1]);
+        string passwordHash(fields[2]);
+        
+        shared_ptr<User> user;
+        switch (static_cast<User::Role>(roleValue)) {
+            case User::Role::STUDENT:
+                user = make_shared<Student>(name, passwordHash, id);
+                break;
+            case User::Role::PROFESSOR:
+                user = make_shared<Professor>(name, passwordHash, id);
+                break;
+        }
+        
+        if (user) {
+            users[name] = user;
         }
     }
-    file.close();
     return users;
 }
 
 vector<shared_ptr<Subject>> DataManager::loadSubjects() {
     vector<shared_ptr<Subject>> subjects;
-    ifstream file(DATA_DIR + "/subjects.txt");
-    if (!file.is_open()) {
+    MappedFile file(DATA_DIR + "/subjects.txt");
+    if (!file.isOpen()) {
         return subjects;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string name, code, profIdStr;
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
         
-        if (getline(ss, name, ',') &&
-            getline(ss, code, ',') &&
-            getline(ss, profIdStr, ',')) {
-            
-            int profId = stoi(profIdStr);
-            subjects.push_back(make_shared<Subject>(name, code, profId));
+        int profId;
+        if (fields.size() < 3 || !parseInt(fields[2], profId)) {
+            reportMalformedLine("subjects.txt", reader.getLineNumber());
+            continue;
         }
+        
+        subjects.push_back(make_shared<Subject>(string(fields[0]), string(fields[1]), profId));
     }
-    file.close();
     return subjects;
 }
 
 map<string, DataSubjectGrades> DataManager::loadSubjectGrades() {
     map<string, DataSubjectGrades> subjectGradesMap;
-    ifstream file(DATA_DIR + "/subject_grades.txt");
-    if (!file.is_open()) {
+    MappedFile file(DATA_DIR + "/subject_grades.txt");
+    if (!file.isOpen()) {
         return subjectGradesMap;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string type, subjectName, studentIdStr, itemName, gradeStr;
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
         
-        if (getline(ss, type, ',') &&
-            getline(ss, subjectName, ',') &&
-            getline(ss, studentIdStr, ',') &&
-            getline(ss, itemName, ',') &&
-            getline(ss, gradeStr, ',')) {
-            
-            int studentId = stoi(studentIdStr);
-            double grade = stod(gradeStr);
-            
-            if (subjectGradesMap.find(subjectName) == subjectGradesMap.end()) {
-                subjectGradesMap[subjectName] = DataSubjectGrades();
-                subjectGradesMap[subjectName].subjectName = subjectName;
-            }
-            
-            if (type == "ASSIGNMENT") {
-                subjectGradesMap[subjectName].assignmentGrades[studentId][itemName] = grade;
-            } else if (type == "REPORT") {
-                subjectGradesMap[subjectName].reportGrades[studentId][itemName] = grade;
-            }
+        int studentId;
+        double grade;
+        if (fields.size() < 5 || !parseInt(fields[2], studentId) || !parseDouble(fields[4], grade)) {
+            reportMalformedLine("subject_grades.txt", reader.getLineNumber());
+            continue;
+        }
+        
+        string subjectName(fields[1]);
+        auto& subjectGrades = subjectGradesMap[subjectName];
+        subjectGrades.subjectName = subjectName;
+        
+        if (fields[0] == "ASSIGNMENT") {
+            subjectGrades.assignmentGrades[studentId][string(fields[3])] = grade;
+        } else if (fields[0] == "REPORT") {
+            subjectGrades.reportGrades[studentId][string(fields[3])] = grade;
         }
     }
-    file.close();
     return subjectGradesMap;
 }
 
 vector<shared_ptr<Assignment>> DataManager::loadAssignments() {
     vector<shared_ptr<Assignment>> assignments;
-    ifstream file(DATA_DIR + "/assignments.txt");
-    if (!file.is_open()) {
+    MappedFile file(DATA_DIR + "/assignments.txt");
+    if (!file.isOpen()) {
         return assignments;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string name, description, maxScoreStr, subjectName;
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
         
-        if (getline(ss, name, ',') &&
-            getline(ss, description, ',') &&
-            getline(ss, maxScoreStr, ',') &&
-            getline(ss, subjectName, ',')) {
-            
-            double maxScore = stod(maxScoreStr);
-            assignments.push_back(make_shared<Assignment>(name, subjectName, maxScore));
+        double maxScore;
+        if (fields.size() < 4 || !parseDouble(fields[2], maxScore)) {
+            reportMalformedLine("assignments.txt", reader.getLineNumber());
+            continue;
         }
+        
+        assignments.push_back(make_shared<Assignment>(string(fields[0]), string(fields[3]), maxScore));
     }
-    file.close();
     return assignments;
 }
 
 vector<shared_ptr<Report>> DataManager::loadReports() {
     vector<shared_ptr<Report>> reports;
-    ifstream file(DATA_DIR + "/reports.txt");
-    if (!file.is_open()) {
+    MappedFile file(DATA_DIR + "/reports.txt");
+    if (!file.isOpen()) {
         return reports;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string topic, subjectName, maxPartStr, completedStr;
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
         
-        if (getline(ss, topic, ',') &&
-            getline(ss, subjectName, ',') &&
-            getline(ss, maxPartStr, ',') &&
-            getline(ss, completedStr, ',')) {
-            
-            int maxParticipants = stoi(maxPartStr);
-            auto report = make_shared<Report>(topic, subjectName, maxParticipants);
-            
-            string studentIdStr;
-            while (getline(ss, studentIdStr, ',')) {
-                if (!studentIdStr.empty()) {
-                    int studentId = stoi(studentIdStr);
-                    report->addStudent(studentId);
-                }
-            }
-            
-            if (completedStr == "1") {
-                report->markAsCompleted();
+        int maxParticipants;
+        if (fields.size() < 4 || !parseInt(fields[2], maxParticipants)) {
+            reportMalformedLine("reports.txt", reader.getLineNumber());
+            continue;
+        }
+        
+        auto report = make_shared<Report>(string(fields[0]), string(fields[1]), maxParticipants);
+        
+        bool valid = true;
+        for (size_t i = 4; i < fields.size(); i++) {
+            if (fields[i].empty()) continue;
+            int studentId;
+            if (!parseInt(fields[i], studentId)) {
+                valid = false;
+                break;
             }
-            
-            reports.push_back(report);
+            report->addStudent(studentId);
+        }
+        if (!valid) {
+            reportMalformedLine("reports.txt", reader.getLineNumber());
+            continue;
+        }
+        
+        if (fields[3] == "1") {
+            report->markAsCompleted();
         }
+        
+        reports.push_back(report);
     }
-    file.close();
     return reports;
 }
 
-map<int, vector<string>> DataManager::loadEnrollments() {
-    map<int, vector<string>> enrollments;
-    ifstream file(DATA_DIR + "/enrollments.txt");
-    if (!file.is_open()) {
+map<int, set<string>> DataManager::loadEnrollments() {
+    map<int, set<string>> enrollments;
+    MappedFile file(DATA_DIR + "/enrollments.txt");
+    if (!file.isOpen()) {
         return enrollments;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string studentIdStr;
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
         
-        if (getline(ss, studentIdStr, ',')) {
-            int studentId = stoi(studentIdStr);
-            vector<string> subjects;
-            string subjectName;
-            
-            while (getline(ss, subjectName, ',')) {
-                subjects.push_back(subjectName);
-            }
-            
-            enrollments[studentId] = subjects;
+        int studentId;
+        if (!parseInt(fields[0], studentId)) {
+            reportMalformedLine("enrollments.txt", reader.getLineNumber());
+            continue;
+        }
+        
+        // Повторы в строке (и повторные строки одного студента) схлопываются
+        auto& subjects = enrollments[studentId];
+        for (size_t i = 1; i < fields.size(); i++) {
+            subjects.emplace(fields[i]);
         }
     }
-    file.close();
     return enrollments;
 }
 
 vector<DataSubmission> DataManager::loadSubmissions() {
     vector<DataSubmission> submissions;
-    ifstream file(DATA_DIR + "/submissions.txt");
-    if (!file.is_open()) {
+    MappedFile file(DATA_DIR + "/submissions.txt");
+    if (!file.isOpen()) {
         return submissions;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
+        
         DataSubmission submission;
-        string studentIdStr;
+        if (fields.size() < 5 || !parseInt(fields[0], submission.studentId)) {
+            reportMalformedLine("submissions.txt", reader.getLineNumber());
+            continue;
+        }
         
-        if (getline(ss, studentIdStr, ',') &&
-            getline(ss, submission.subjectName, ',') &&
-            getline(ss, submission.assignmentName, ',') &&
-            getline(ss, submission.status, ',') &&
-            getline(ss, submission.timestamp, ',')) {
-            
-            submission.studentId = stoi(studentIdStr);
-            submissions.push_back(submission);
+        submission.subjectName = string(fields[1]);
+        submission.assignmentName = string(fields[2]);
+        submission.status = string(fields[3]);
+        submission.timestamp = parseTimestamp(fields[4]);
+        // Тип добавлен в конец строки: в старых файлах его нет, его определяет loadAllData
+        if (fields.size() >= 6) {
+            submission.type = string(fields[5]);
         }
+        submissions.push_back(move(submission));
     }
-    file.close();
     return submissions;
 }
 
 vector<DataGrade> DataManager::loadGrades() {
     vector<DataGrade> grades;
-    ifstream file(DATA_DIR + "/grades.txt");
-    if (!file.is_open()) {
+    MappedFile file(DATA_DIR + "/grades.txt");
+    if (!file.isOpen()) {
         return grades;
     }
     
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        DataGrade grade;
-        string studentIdStr, scoreStr;
+    LineReader reader(file.getContents());
+    vector<string_view> fields;
+    string_view line;
+    while (reader.next(line)) {
+        splitFields(line, fields);
+        if (fields.empty()) continue;
         
-        if (getline(ss, studentIdStr, ',') &&
-            getline(ss, grade.subjectName, ',') &&
-            getline(ss, grade.assignmentName, ',') &&
-            getline(ss, scoreStr, ',') &&
-            getline(ss, grade.type, ',') &&
-            getline(ss, grade.timestamp, ',')) {
-            
-            grade.studentId = stoi(studentIdStr);
-            grade.score = stod(scoreStr);
-            grades.push_back(grade);
+        DataGrade grade;
+        if (fields.size() < 6 || !parseInt(fields[0], grade.studentId) ||
+            !parseDouble(fields[3], grade.score)) {
+            reportMalformedLine("grades.txt", reader.getLineNumber());
+            continue;
         }
+        
+        grade.subjectName = string(fields[1]);
+        grade.assignmentName = string(fields[2]);
+        grade.type = string(fields[4]);
+        grade.timestamp = parseTimestamp(fields[5]);
+        grades.push_back(move(grade));
     }
-    file.close();
     return grades;
 }
 
-string DataManager::getCurrentTimestamp() {
-    time_t now = time(nullptr);
-    tm* tm = localtime(&now);
+long long DataManager::getCurrentTimestamp() {
+    return static_cast<long long>(time(nullptr));
+}
+
+long long DataManager::parseTimestamp(string_view timestamp) {
+    long long epoch;
+    if (parseInt(timestamp, epoch)) {
+        return epoch;
+    }
+    
+    // Старые файлы хранят время строкой "ГГГГ-ММ-ДД ЧЧ:ММ:СС"
+    string text(timestamp);
+    tm tm = {};
+    if (sscanf(text.c_str(), "%d-%d-%d %d:%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+               &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
+        return 0;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    tm.tm_isdst = -1;
+    return static_cast<long long>(mktime(&tm));
+}
+
+string DataManager::formatTimestamp(long long epoch) {
+    if (epoch == 0) {
+        return "";
+    }
+    time_t time = static_cast<time_t>(epoch);
+    tm* tm = localtime(&time);
     char buffer[20];
     strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", tm);
     return string(buffer);
-}
\ No newline at end of file
+}
+
+// ==================== БИНАРНЫЙ СНИМОК ====================
+// Формат snapshot.bin (все секции выровнены по 8 байт):
+//   заголовок SnapshotHeader
+//   таблица строк: смещения uint32[stringCount + 1], затем байты строк
+//   сдачи:  timestamp int64[n], studentId int32[n], subject/item/status/type uint32[n]
+//           (колонки type нет в версии 1)
+//   оценки: score double[n], timestamp int64[n], studentId int32[n], subject/item/type uint32[n]
+// Названия предметов, заданий, статусы и типы хранятся один раз в таблице строк.
+
+namespace {
+
+const char SNAPSHOT_MAGIC[4] = {'U', 'S', 'N', 'P'};
+const uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t stringCount;
+    uint32_t stringBytes;
+    uint32_t submissionCount;
+    uint32_t gradeCount;
+};
+
+class StringTable {
+private:
+    unordered_map<string, uint32_t> ids;
+    vector<string> strings;
+
+public:
+    uint32_t intern(const string& value) {
+        auto it = ids.find(value);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        uint32_t id = strings.size();
+        ids.emplace(value, id);
+        strings.push_back(value);
+        return id;
+    }
+    const vector<string>& getStrings() const { return strings; }
+};
+
+template <typename T>
+void writeColumn(ofstream& file, const vector<T>& column) {
+    file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+}
+
+void writePadding(ofstream& file) {
+    static const char zeros[8] = {};
+    auto position = static_cast<size_t>(file.tellp());
+    if (position % 8 != 0) {
+        file.write(zeros, 8 - position % 8);
+    }
+}
+
+// Последовательное чтение колонок из отображенного файла с проверкой границ
+class SnapshotReader {
+private:
+    string_view contents;
+    size_t offset;
+
+    // Непрочитанный остаток (после skipPadding смещение может оказаться за концом файла)
+    size_t remaining() const { return offset < contents.size() ? contents.size() - offset : 0; }
+
+public:
+    explicit SnapshotReader(string_view contents) : contents(contents), offset(0) {}
+
+    // Размеры берутся из заголовка файла, поэтому сравниваются с остатком делением, без переполнения
+    template <typename T>
+    bool readColumn(vector<T>& column, size_t count) {
+        if (count > remaining() / sizeof(T)) {
+            return false;
+        }
+        size_t bytes = count * sizeof(T);
+        column.resize(count);
+        memcpy(column.data(), contents.data() + offset, bytes);
+        offset += bytes;
+        return true;
+    }
+
+    bool readBytes(string_view& bytes, size_t count) {
+        if (count > remaining()) {
+            return false;
+        }
+        bytes = contents.substr(offset, count);
+        offset += count;
+        return true;
+    }
+
+    void skipPadding() {
+        offset = (offset + 7) / 8 * 8;
+    }
+};
+
+}
+
+void DataManager::saveSnapshot(const vector<DataSubmission>& submissions, const vector<DataGrade>& grades) {
+    StringTable table;
+    
+    vector<long long> submissionTimes;
+    vector<int32_t> submissionStudents;
+    vector<uint32_t> submissionSubjects, submissionItems, submissionStatuses, submissionTypes;
+    for (const auto& submission : submissions) {
+        submissionTimes.push_back(submission.timestamp);
+        submissionStudents.push_back(submission.studentId);
+        submissionSubjects.push_back(table.intern(submission.subjectName));
+        submissionItems.push_back(table.intern(submission.assignmentName));
+        submissionStatuses.push_back(table.intern(submission.status));
+        submissionTypes.push_back(table.intern(submission.type));
+    }
+    
+    vector<double> gradeScores;
+    vector<long long> gradeTimes;
+    vector<int32_t> gradeStudents;
+    vector<uint32_t> gradeSubjects, gradeItems, gradeTypes;
+    for (const auto& grade : grades) {
+        gradeScores.push_back(grade.score);
+        gradeTimes.push_back(grade.timestamp);
+        gradeStudents.push_back(grade.studentId);
+        gradeSubjects.push_back(table.intern(grade.subjectName));
+        gradeItems.push_back(table.intern(grade.assignmentName));
+        gradeTypes.push_back(table.intern(grade.type));
+    }
+    
+    vector<uint32_t> stringOffsets = {0};
+    string stringBytes;
+    for (const auto& value : table.getStrings()) {
+        stringBytes += value;
+        stringOffsets.push_back(stringBytes.size());
+    }
+    
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.stringCount = table.getStrings().size();
+    header.stringBytes = stringBytes.size();
+    header.submissionCount = submissions.size();
+    header.gradeCount = grades.size();
+    
+    // Снимок подменяется целиком при фиксации (commitStaged)
+    ofstream file(stagingPath("snapshot.bin"), ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        stage("snapshot.bin", file);
+        return;
+    }
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writePadding(file);
+    writeColumn(file, stringOffsets);
+    file.write(stringBytes.data(), stringBytes.size());
+    writePadding(file);
+    
+    writeColumn(file, submissionTimes);
+    writeColumn(file, submissionStudents);
+    writeColumn(file, submissionSubjects);
+    writeColumn(file, submissionItems);
+    writeColumn(file, submissionStatuses);
+    writeColumn(file, submissionTypes);
+    writePadding(file);
+    
+    writeColumn(file, gradeScores);
+    writeColumn(file, gradeTimes);
+    writeColumn(file, gradeStudents);
+    writeColumn(file, gradeSubjects);
+    writeColumn(file, gradeItems);
+    writeColumn(file, gradeTypes);
+    writePadding(file);
+    
+    stage("snapshot.bin", file);
+}
+
+bool DataManager::loadSnapshot(vector<DataSubmission>& submissions, vector<DataGrade>& grades) {
+    MappedFile file(DATA_DIR + "/snapshot.bin");
+    if (!file.isOpen()) {
+        return false;
+    }
+    
+    string_view contents = file.getContents();
+    SnapshotHeader header;
+    if (contents.size() < sizeof(header)) {
+        cout << "Предупреждение: файл snapshot.bin поврежден, используются текстовые файлы\n";
+        return false;
+    }
+    memcpy(&header, contents.data(), sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version == 0 || header.version > SNAPSHOT_VERSION) {
+        cout << "Предупреждение: неизвестный формат snapshot.bin, используются текстовые файлы\n";
+        return false;
+    }
+    
+    SnapshotReader reader(contents);
+    string_view headerBytes;
+    reader.readBytes(headerBytes, sizeof(header));
+    reader.skipPadding();
+    
+    vector<uint32_t> stringOffsets;
+    string_view stringBytes;
+    // Смещений на одно больше, чем строк; сумма в size_t, чтобы stringCount = UINT32_MAX не обнулил ее
+    bool ok = reader.readColumn(stringOffsets, size_t(header.stringCount) + 1) &&
+              reader.readBytes(stringBytes, header.stringBytes);
+    reader.skipPadding();
+    
+    vector<string> strings;
+    for (uint32_t i = 0; ok && i < header.stringCount; i++) {
+        if (stringOffsets[i] > stringOffsets[i + 1] || stringOffsets[i + 1] > stringBytes.size()) {
+            ok = false;
+            break;
+        }
+        strings.emplace_back(stringBytes.substr(stringOffsets[i], stringOffsets[i + 1] - stringOffsets[i]));
+    }
+    
+    size_t n = header.submissionCount;
+    vector<long long> submissionTimes;
+    vector<int32_t> submissionStudents;
+    vector<uint32_t> submissionSubjects, submissionItems, submissionStatuses, submissionTypes;
+    ok = ok && reader.readColumn(submissionTimes, n) &&
+         reader.readColumn(submissionStudents, n) &&
+         reader.readColumn(submissionSubjects, n) &&
+         reader.readColumn(submissionItems, n) &&
+         reader.readColumn(submissionStatuses, n);
+    bool hasTypes = header.version >= 2;
+    ok = ok && (!hasTypes || reader.readColumn(submissionTypes, n));
+    reader.skipPadding();
+    
+    size_t m = header.gradeCount;
+    vector<double> gradeScores;
+    vector<long long> gradeTimes;
+    vector<int32_t> gradeStudents;
+    vector<uint32_t> gradeSubjects, gradeItems, gradeTypes;
+    ok = ok && reader.readColumn(gradeScores, m) &&
+         reader.readColumn(gradeTimes, m) &&
+         reader.readColumn(gradeStudents, m) &&
+         reader.readColumn(gradeSubjects, m) &&
+         reader.readColumn(gradeItems, m) &&
+         reader.readColumn(gradeTypes, m);
+    
+    auto validId = [&](uint32_t id) { return id < strings.size(); };
+    for (size_t i = 0; ok && i < n; i++) {
+        ok = validId(submissionSubjects[i]) && validId(submissionItems[i]) && validId(submissionStatuses[i]) &&
+             (!hasTypes || validId(submissionTypes[i]));
+    }
+    for (size_t i = 0; ok && i < m; i++) {
+        ok = validId(gradeSubjects[i]) && validId(gradeItems[i]) && validId(gradeTypes[i]);
+    }
+    
+    if (!ok) {
+        cout << "Предупреждение: файл snapshot.bin поврежден, используются текстовые файлы\n";
+        return false;
+    }
+    
+    submissions.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        auto& submission = submissions[i];
+        submission.studentId = submissionStudents[i];
+        submission.subjectName = strings[submissionSubjects[i]];
+        submission.assignmentName = strings[submissionItems[i]];
+        submission.status = strings[submissionStatuses[i]];
+        submission.timestamp = submissionTimes[i];
+        if (hasTypes) {
+            submission.type = strings[submissionTypes[i]];
+        }
+    }
+    
+    grades.resize(m);
+    for (size_t i = 0; i < m; i++) {
+        auto& grade = grades[i];
+        grade.studentId = gradeStudents[i];
+        grade.subjectName = strings[gradeSubjects[i]];
+        grade.assignmentName = strings[gradeItems[i]];
+        grade.type = strings[gradeTypes[i]];
+        grade.score = gradeScores[i];
+        grade.timestamp = gradeTimes[i];
+    }
+    return true;
+}
+
+void DataManager::exportSnapshotToText() {
+    recoverCheckpoint();
+    vector<DataSubmission> submissions;
+    vector<DataGrade> grades;
+    if (!loadSnapshot(submissions, grades)) {
+        cout << "Снимок snapshot.bin не найден\n";
+        return;
+    }
+    
+    saveSubmissions(submissions);
+    saveGrades(grades);
+    if (!commitStaged()) {
+        return;
+    }
+    cout << "Экспортировано: " << submissions.size() << " сдач, " 
+         << grades.size() << " оценок\n";
+}
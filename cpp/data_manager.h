@@ -3,8 +3,12 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <set>
+#include <string_view>
+#include <iosfwd>
 
 class User;
+class JournalWriter;
 class Subject;
 class Assignment;
 class Report;
@@ -18,7 +22,8 @@ struct DataSubmission {
     string subjectName;     // Название предмета
     string assignmentName;  // Название задания/доклада
     string status;          // Статус: "pending", "approved", "rejected"
-    string timestamp;       // Время сдачи
+    long long timestamp;    // Время сдачи (секунды эпохи)
+    string type;            // Тип: "assignment" или "report" (пусто в файлах старого формата)
 };
 
 // структура для серелизации данных о оценке
@@ -28,7 +33,7 @@ struct DataGrade {
     string assignmentName;  // Название задания/доклада
     double score;           // Оценка
     string type;            // Тип: "assignment" (задание) или "report" (доклад)
-    string timestamp;       // Время выставления оценки
+    long long timestamp;    // Время выставления оценки (секунды эпохи)
 };
 
 // структура для хранения оценок
@@ -38,42 +43,106 @@ struct DataSubjectGrades {
     map<int, map<string, double>> reportGrades;     // Оценки за доклады
 };
 
+// запись журнала изменений (journal.log)
+// Каждая мутация дописывает одну такую строку вместо перезаписи всех файлов
+struct JournalRecord {
+    long long seq;          // Порядковый номер записи
+    string type;            // Тип операции: "USER", "SUBJECT", "GRADE", ...
+    vector<string> fields;  // Аргументы операции
+    size_t lineNumber;      // Строка journal.log, для сообщения о поврежденной записи
+};
+
+// коллекции, которые сохраняются в отдельные файлы (битовая маска измененных данных)
+enum DataCollection : unsigned {
+    DATA_USERS = 1 << 0,           // users.txt
+    DATA_SUBJECTS = 1 << 1,        // subjects.txt
+    DATA_ASSIGNMENTS = 1 << 2,     // assignments.txt
+    DATA_REPORTS = 1 << 3,         // reports.txt
+    DATA_ENROLLMENTS = 1 << 4,     // enrollments.txt
+    DATA_SUBMISSIONS = 1 << 5,     // submissions.txt (или snapshot.bin)
+    DATA_GRADES = 1 << 6,          // grades.txt (или snapshot.bin)
+    DATA_SUBJECT_GRADES = 1 << 7,  // subject_grades.txt
+    DATA_NEXT_ID = 1 << 8,         // next_id.txt
+    DATA_ALL = (1 << 9) - 1
+};
+
 class DataManager {
 private:
     static const string DATA_DIR;  // Путь к директории данных
+    static bool journalMode;       // Писать изменения в журнал вместо полного сохранения
+    static long long journalSeq;   // Номер последней записи журнала
+    static int journalSize;        // Количество записей с момента последней контрольной точки
+    static bool binarySnapshot;    // Хранить оценки и сдачи в snapshot.bin вместо текстовых файлов
+    static unique_ptr<JournalWriter> journalWriter;  // Фоновый поток записи журнала (если включен)
+    
+    static vector<string> stagedFiles;  // Файлы, записанные во временные *.tmp и ожидающие фиксации
+    static bool stagingFailed;          // Один из временных файлов не записан - фиксация отменяется
+    
+    // фиксация набора файлов: save* пишут в data/<файл>.tmp, commitStaged подменяет их разом
+    static string stagingPath(const string& fileName);           // Путь временного файла, файл отмечается к фиксации
+    static void stage(const string& fileName, ofstream& file);   // Закрыть временный файл, проверить открытие и запись
+    static bool commitStaged(const vector<string>& removed = {});  // Подменить отмеченные файлы, удалить removed
+    static void applyCommit();                                   // Выполнить подмену по манифесту commit.txt
     
 public:
+    static const int JOURNAL_CHECKPOINT_INTERVAL = 500;  // Записей журнала между контрольными точками
+    
     static void initDataDirectory();  // Создает папку "data/" если её нет
+    static void recoverCheckpoint();  // Довершить прерванную фиксацию и убрать недописанные *.tmp
     
     // сохранение данных, каждый метод записывает свой тип данных в отдельный файл
     static void saveUsers(const map<string, shared_ptr<User>>& users);           // users.txt
     static void saveSubjects(const vector<shared_ptr<Subject>>& subjects);       // subjects.txt
     static void saveAssignments(const vector<shared_ptr<Assignment>>& assignments); // assignments.txt
     static void saveReports(const vector<shared_ptr<Report>>& reports);          // reports.txt
-    static void saveEnrollments(const map<int, vector<string>>& studentEnrollments); // enrollments.txt
+    static void saveEnrollments(const map<int, set<string>>& studentEnrollments); // enrollments.txt
     static void saveSubmissions(const vector<DataSubmission>& submissions);      // submissions.txt
     static void saveGrades(const vector<DataGrade>& grades);                     // grades.txt
     static void saveSubjectGrades(const vector<shared_ptr<Subject>>& subjects);  // subject_grades.txt
     static void saveNextUserId(int nextId);                                      // next_id.txt
     
-    // чтение из файлов и восстановление объектов
+    // чтение из файлов и восстановление объектов (файлы отображаются в память, см. MappedFile)
     static map<string, shared_ptr<User>> loadUsers();
     static vector<shared_ptr<Subject>> loadSubjects();
     static vector<shared_ptr<Assignment>> loadAssignments();
     static vector<shared_ptr<Report>> loadReports();
-    static map<int, vector<string>> loadEnrollments();
+    static map<int, set<string>> loadEnrollments();
     static vector<DataSubmission> loadSubmissions();
     static vector<DataGrade> loadGrades();
     static map<string, DataSubjectGrades> loadSubjectGrades();
     static int loadNextUserId();  // Загрузка следующего доступного ID пользователя
     
-    static string getCurrentTimestamp();  // Получение текущей даты/времени в формате строки
+    // журнал изменений: файлы выше служат контрольной точкой, journal.log хранит хвост изменений
+    static void setJournalMode(bool enabled) { journalMode = enabled; }
+    static bool isJournalMode() { return journalMode; }
+    static void appendJournal(const string& type, const vector<string>& fields);  // Дописать запись в journal.log
+    static vector<JournalRecord> loadJournal();  // Записи журнала после последней контрольной точки
+    static void reportMalformedLine(const string& fileName, size_t lineNumber);  // Сообщить о некорректной строке (файла или журнала)
+    static bool needsCheckpoint() { return journalSize >= JOURNAL_CHECKPOINT_INTERVAL; }
+    
+    // групповая фиксация: журнал пишет фоновый поток, пакетами раз в windowMs миллисекунд
+    static void startJournalWriter(int windowMs);
+    static void stopJournalWriter();  // Дописать очередь и остановить поток
+    static bool waitForJournal();     // Дождаться, пока все записи журнала окажутся на диске (false - ошибка записи)
+    
+    // бинарный колоночный снимок сдач и оценок (snapshot.bin) вместо submissions.txt и grades.txt
+    static void setBinarySnapshot(bool enabled) { binarySnapshot = enabled; }
+    static bool isBinarySnapshot() { return binarySnapshot; }
+    static void saveSnapshot(const vector<DataSubmission>& submissions, const vector<DataGrade>& grades);
+    static bool loadSnapshot(vector<DataSubmission>& submissions, vector<DataGrade>& grades); // false, если снимка нет или он поврежден
+    static void exportSnapshotToText();  // Выгрузка snapshot.bin в submissions.txt и grades.txt
+    
+    static long long getCurrentTimestamp();  // Текущее время в секундах эпохи
+    static long long parseTimestamp(string_view timestamp);  // Секунды эпохи или старый формат "ГГГГ-ММ-ДД ЧЧ:ММ:СС" (0, если не разобрано)
+    static string formatTimestamp(long long epoch);           // Секунды эпохи -> "ГГГГ-ММ-ДД ЧЧ:ММ:СС" для вывода
     
-    static void saveAllData(const map<string, shared_ptr<User>>& users,
+    // false - файлы не удалось записать, контрольная точка и журнал остались прежними
+    static bool saveAllData(const map<string, shared_ptr<User>>& users,
                            const vector<shared_ptr<Subject>>& subjects,
                            const vector<shared_ptr<Assignment>>& assignments,
                            const vector<shared_ptr<Report>>& reports,
-                           const map<int, vector<string>>& studentEnrollments,
+                           const map<int, set<string>>& studentEnrollments,
                            const vector<DataSubmission>& submissions,
-                           const vector<DataGrade>& grades);
+                           const vector<DataGrade>& grades,
+                           unsigned collections = DATA_ALL);  // Перезаписываются только файлы из маски
 };
\ No newline at end of file
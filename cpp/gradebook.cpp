@@ -0,0 +1,154 @@
+#include "gradebook.h"
+#include <algorithm>
+
+using namespace std;
+
+size_t Gradebook::addRow(int studentId) {
+    auto it = rowOf.find(studentId);
+    if (it != rowOf.end()) {
+        return it->second;
+    }
+
+    size_t row = studentIds.size();
+    studentIds.push_back(studentId);
+    rowOf.emplace(studentId, row);
+    scores.resize(scores.size() + stride, 0.0f);
+    valid.resize(valid.size() + maskWords(), 0);
+    return row;
+}
+
+size_t Gradebook::addColumn(Symbol itemId) {
+    auto it = columnOf.find(itemId);
+    if (it != columnOf.end()) {
+        return it->second;
+    }
+
+    size_t column = itemIds.size();
+    itemIds.push_back(itemId);
+    columnOf.emplace(itemId, column);
+    if (column < stride) {
+        return column;
+    }
+
+    // Места в строках нет: удваиваем ширину и переносим строки целиком
+    size_t newStride = max<size_t>(4, stride * 2);
+    size_t newWords = (newStride + 63) / 64;
+    vector<float> newScores(studentIds.size() * newStride, 0.0f);
+    vector<uint64_t> newValid(studentIds.size() * newWords, 0);
+    for (size_t row = 0; row < studentIds.size(); row++) {
+        copy_n(scores.begin() + row * stride, stride, newScores.begin() + row * newStride);
+        copy_n(valid.begin() + row * maskWords(), maskWords(), newValid.begin() + row * newWords);
+    }
+    stride = newStride;
+    scores.swap(newScores);
+    valid.swap(newValid);
+    return column;
+}
+
+void Gradebook::setGrade(int studentId, Symbol itemId, double grade) {
+    size_t column = addColumn(itemId);
+    size_t row = addRow(studentId);
+    scores[row * stride + column] = static_cast<float>(grade);
+    valid[row * maskWords() + column / 64] |= uint64_t(1) << (column % 64);
+}
+
+double Gradebook::getGrade(int studentId, Symbol itemId) const {
+    auto itRow = rowOf.find(studentId);
+    auto itColumn = columnOf.find(itemId);
+    if (itRow == rowOf.end() || itColumn == columnOf.end() ||
+        !isValid(itRow->second, itColumn->second)) {
+        return -1.0;
+    }
+    return scores[itRow->second * stride + itColumn->second];
+}
+
+bool Gradebook::hasGrades(int studentId) const {
+    auto it = rowOf.find(studentId);
+    if (it == rowOf.end()) {
+        return false;
+    }
+    auto mask = valid.begin() + it->second * maskWords();
+    return any_of(mask, mask + maskWords(), [](uint64_t word) { return word != 0; });
+}
+
+vector<pair<string, double>> Gradebook::getStudentGrades(int studentId) const {
+    vector<pair<string, double>> result;
+    auto it = rowOf.find(studentId);
+    if (it == rowOf.end()) {
+        return result;
+    }
+
+    size_t row = it->second;
+    const float* rowScores = scores.data() + row * stride;
+    for (size_t column = 0; column < itemIds.size(); column++) {
+        if (isValid(row, column)) {
+            result.emplace_back(SymbolTable::name(itemIds[column]), rowScores[column]);
+        }
+    }
+    // Порядок как у прежнего map<string, double>: по названию
+    sort(result.begin(), result.end());
+    return result;
+}
+
+ScoreSummary Gradebook::summarizeStudent(int studentId) const {
+    auto it = rowOf.find(studentId);
+    if (it == rowOf.end()) {
+        return ScoreSummary();
+    }
+    return summarizeScores(scores.data() + it->second * stride,
+                           valid.data() + it->second * maskWords(), itemIds.size());
+}
+
+ScoreSummary Gradebook::summarizeAll() const {
+    // Строки выровнены по stride, а маска - по словам, поэтому сводки считаются по строкам
+    ScoreSummary summary;
+    for (size_t row = 0; row < studentIds.size(); row++) {
+        summary.merge(summarizeScores(scores.data() + row * stride,
+                                      valid.data() + row * maskWords(), itemIds.size()));
+    }
+    return summary;
+}
+
+void Gradebook::histogram(double low, double high, vector<size_t>& buckets) const {
+    for (size_t row = 0; row < studentIds.size(); row++) {
+        histogramScores(scores.data() + row * stride, valid.data() + row * maskWords(),
+                        itemIds.size(), low, high, buckets);
+    }
+}
+
+vector<tuple<int, Symbol, double>> Gradebook::entries() const {
+    vector<tuple<int, Symbol, double>> result;
+    for (size_t row = 0; row < studentIds.size(); row++) {
+        const float* rowScores = scores.data() + row * stride;
+        for (size_t column = 0; column < itemIds.size(); column++) {
+            if (isValid(row, column)) {
+                result.emplace_back(studentIds[row], itemIds[column], rowScores[column]);
+            }
+        }
+    }
+    return result;
+}
+
+map<int, map<string, double>> Gradebook::toMap() const {
+    map<int, map<string, double>> result;
+    for (const auto& [studentId, itemId, grade] : entries()) {
+        result[studentId][SymbolTable::name(itemId)] = grade;
+    }
+    return result;
+}
+
+void Gradebook::assign(const map<int, map<string, double>>& grades) {
+    studentIds.clear();
+    rowOf.clear();
+    itemIds.clear();
+    columnOf.clear();
+    stride = 0;
+    scores.clear();
+    valid.clear();
+
+    for (const auto& [studentId, studentGrades] : grades) {
+        for (const auto& [itemName, grade] : studentGrades) {
+            setGrade(studentId, SymbolTable::intern(itemName), grade);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <tuple>
+#include "score_kernels.h"
+#include "symbol_table.h"
+
+using namespace std;
+
+// ПЛОТНЫЙ ЖУРНАЛ ОЦЕНОК ПРЕДМЕТА (студенты x элементы)
+// Оценки лежат одной матрицей float по строкам (строка - студент, столбец - задание
+// или доклад), отсутствие оценки отмечается битовой маской. Строка студента - непрерывный
+// участок памяти, столбец - проход с постоянным шагом, без поиска по деревьям.
+class Gradebook {
+private:
+    vector<int> studentIds;                 // ID студента по номеру строки
+    unordered_map<int, size_t> rowOf;       // Номер строки по ID студента
+    vector<Symbol> itemIds;                 // Элемент (SymbolTable) по номеру столбца
+    unordered_map<Symbol, size_t> columnOf; // Номер столбца по элементу
+    size_t stride = 0;                      // Столбцов, под которые выделена каждая строка
+    vector<float> scores;                   // Оценки: строка * stride + столбец
+    vector<uint64_t> valid;                 // Маска выставленных оценок: строка * maskWords() + столбец / 64
+
+    size_t maskWords() const { return (stride + 63) / 64; }
+    size_t addRow(int studentId);                    // Строка студента (создается при первой оценке)
+    size_t addColumn(Symbol itemId);                 // Столбец элемента (при нехватке места матрица расширяется)
+    bool isValid(size_t row, size_t column) const {
+        return (valid[row * maskWords() + column / 64] >> (column % 64)) & 1;
+    }
+
+public:
+    void setGrade(int studentId, Symbol itemId, double grade);             // Выставить оценку
+    double getGrade(int studentId, Symbol itemId) const;                    // Оценка или -1.0, если ее нет
+    bool hasGrades(int studentId) const;                                     // Есть ли у студента хоть одна оценка
+    vector<pair<string, double>> getStudentGrades(int studentId) const;     // Оценки студента по названию элемента
+    ScoreSummary summarizeStudent(int studentId) const;                      // Сводка по строке студента
+    ScoreSummary summarizeAll() const;                                       // Сводка по всем оценкам
+    void histogram(double low, double high, vector<size_t>& buckets) const;  // Добавить все оценки в гистограмму
+
+    vector<tuple<int, Symbol, double>> entries() const;          // Все оценки: (студент, элемент, оценка)
+    map<int, map<string, double>> toMap() const;                 // Все оценки по названиям (для сохранения)
+    void assign(const map<int, map<string, double>>& grades);   // Заменить все оценки
+};
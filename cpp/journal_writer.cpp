@@ -0,0 +1,137 @@
+#include "journal_writer.h"
+#include <iostream>
+#include <fstream>
+#include <cerrno>
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define HAS_FSYNC 1
+#endif
+
+using namespace std;
+
+JournalWriter::JournalWriter(const string& path, chrono::milliseconds window, long long lastSeq)
+    : path(path), window(window), pendingSeq(lastSeq), durableSeq(lastSeq), writing(false),
+      failed(false), failedWrites(0), flushRequested(false), stopping(false) {
+    worker = thread(&JournalWriter::run, this);
+}
+
+JournalWriter::~JournalWriter() {
+    {
+        lock_guard<mutex> lock(mtx);
+        stopping = true;
+    }
+    queued.notify_one();
+    worker.join();
+}
+
+void JournalWriter::enqueue(long long seq, const string& line) {
+    lock_guard<mutex> lock(mtx);
+    pendingBytes += line;
+    pendingSeq = seq;
+    queued.notify_one();
+}
+
+void JournalWriter::discardPending() {
+    lock_guard<mutex> lock(mtx);
+    pendingBytes.clear();
+    durableSeq = max(durableSeq, pendingSeq);
+    failed = false;
+    flushed.notify_all();
+}
+
+bool JournalWriter::waitUntilDurable(long long seq) {
+    unique_lock<mutex> lock(mtx);
+    // Очередь пуста и ничего не пишется - все поставленные записи уже на диске
+    auto idle = [&] { return pendingBytes.empty() && !writing; };
+    if (durableSeq >= seq || idle()) {
+        return true;
+    }
+    unsigned long long failuresBefore = failedWrites;
+    flushRequested = true;
+    queued.notify_one();
+    flushed.wait(lock, [&] { return durableSeq >= seq || idle() || failedWrites != failuresBefore; });
+    return durableSeq >= seq || idle();
+}
+
+void JournalWriter::run() {
+    unique_lock<mutex> lock(mtx);
+    while (true) {
+        queued.wait(lock, [&] { return stopping || !pendingBytes.empty(); });
+        if (pendingBytes.empty()) {
+            break;
+        }
+
+        // Собираем все, что придет за окно, если никто не ждет сохранения
+        queued.wait_for(lock, window, [&] { return stopping || flushRequested; });
+
+        string batch;
+        batch.swap(pendingBytes);
+        long long batchSeq = pendingSeq;
+        flushRequested = false;
+        writing = true;
+
+        lock.unlock();
+        bool written = writeDurably(path, batch);
+        lock.lock();
+        writing = false;
+
+        if (written) {
+            durableSeq = batchSeq;
+            failed = false;
+            flushed.notify_all();
+            continue;
+        }
+
+        // Пакет возвращается в начало очереди: записи не считаются сохраненными,
+        // ожидающие получают ошибку, запись повторяется после паузы
+        if (!failed) {
+            cerr << "Ошибка: не удалось записать журнал изменений " << path << endl;
+        }
+        failed = true;
+        failedWrites++;
+        pendingBytes.insert(0, batch);
+        flushed.notify_all();
+        if (stopping) {
+            cerr << "Ошибка: записи журнала до №" << batchSeq << " не сохранены" << endl;
+            break;
+        }
+        queued.wait_for(lock, max(window, chrono::milliseconds(100)), [&] { return stopping; });
+    }
+}
+
+bool JournalWriter::writeDurably(const string& path, const string& bytes) {
+#ifdef HAS_FSYNC
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t result = write(fd, bytes.data() + written, bytes.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close(fd);
+            return false;
+        }
+        written += result;
+    }
+
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+#else
+    ofstream file(path, ios::app | ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << bytes;
+    file.flush();
+    return !file.fail();
+#endif
+}
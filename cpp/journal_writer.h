@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+using namespace std;
+
+// ФОНОВАЯ ЗАПИСЬ ЖУРНАЛА С ГРУППОВОЙ ФИКСАЦИЕЙ
+// Мутации только ставят строки журнала в очередь. Отдельный поток собирает все,
+// что пришло за окно группировки, и фиксирует пакет одной записью с fsync.
+class JournalWriter {
+private:
+    string path;                       // Путь к journal.log
+    chrono::milliseconds window;       // Окно группировки записей
+
+    mutex mtx;
+    condition_variable queued;         // Появились записи или запрошен сброс
+    condition_variable flushed;        // Пакет записан на диск
+    string pendingBytes;               // Строки, ожидающие записи
+    long long pendingSeq;              // Номер последней записи в очереди
+    long long durableSeq;              // Номер последней записи, сохраненной на диск
+    bool writing;                      // Пакет снят с очереди и пишется на диск
+    bool failed;                       // Последняя запись не удалась, пакет ждет повтора в очереди
+    unsigned long long failedWrites;   // Счетчик неудачных записей (будит ожидающих)
+    bool flushRequested;               // Кто-то ждет сохранения - не ждать конца окна
+    bool stopping;                     // Поток завершается
+    thread worker;
+
+    void run();                                  // Цикл фонового потока
+
+public:
+    static bool writeDurably(const string& path, const string& bytes);  // write + fsync (и для записи без потока)
+
+    // lastSeq - номер последней записи, уже лежащей в журнале на диске
+    JournalWriter(const string& path, chrono::milliseconds window, long long lastSeq);
+    ~JournalWriter();                            // Дописывает очередь и останавливает поток
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    void enqueue(long long seq, const string& line);  // Поставить строку журнала в очередь
+    void discardPending();                            // Отбросить очередь: ее записи вошли в контрольную точку
+    bool waitUntilDurable(long long seq);             // Дождаться сохранения записи seq (false - ошибка записи)
+};
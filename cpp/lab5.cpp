@@ -1,10 +1,53 @@
 #include "university_system.h"
+#include "session_server.h"
+#include "session_client.h"
 #include <iostream>
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
+    string serveSocket;
+    int groupCommitMs = -1;
+    int subjectWorkers = -1;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--binary-snapshot") {
+            // Хранить оценки и сдачи в бинарном снимке data/snapshot.bin
+            DataManager::setBinarySnapshot(true);
+        } else if (arg.rfind("--group-commit=", 0) == 0) {
+            // Писать журнал в фоновом потоке, объединяя изменения за указанное число миллисекунд
+            groupCommitMs = stoi(arg.substr(15));
+        } else if (arg.rfind("--subject-workers=", 0) == 0) {
+            // Закрепить предметы за рабочими потоками (0 - по числу ядер)
+            subjectWorkers = stoi(arg.substr(18));
+        } else if (arg == "--export-text") {
+            // Выгрузить снимок обратно в submissions.txt и grades.txt
+            DataManager::exportSnapshotToText();
+            return 0;
+        } else if (arg.rfind("--serve=", 0) == 0) {
+            // Держать данные в памяти и обслуживать клиентов через Unix-сокет
+            serveSocket = arg.substr(8);
+        } else if (arg.rfind("--connect=", 0) == 0) {
+            // Тонкий клиент: меню работают через сервер, данные не загружаются
+            SessionClient client(arg.substr(10));
+            client.run();
+            return client.isConnected() ? 0 : 1;
+        }
+    }
+    
     UniversitySystem system;
+    // Поток журнала запускается после загрузки, когда известен номер последней записи
+    if (groupCommitMs >= 0) {
+        DataManager::startJournalWriter(groupCommitMs);
+    }
+    if (subjectWorkers >= 0) {
+        system.startSubjectWorkers(subjectWorkers);
+    }
+    
+    if (!serveSocket.empty()) {
+        SessionServer server(system, serveSocket);
+        return server.run() ? 0 : 1;
+    }
     
     cout << "========================================\n";
     cout << "    УНИВЕРСИТЕТСКАЯ СИСТЕМА\n";
@@ -13,4 +56,4 @@ int main() {
     
     return 0;
 }
-//g++ -o lab5 data_manager.cpp lab5.cpp object.cpp professor.cpp student.cpp university_system.cpp user.cpp
\ No newline at end of file
+//g++ -pthread -o lab5 data_manager.cpp gradebook.cpp lab5.cpp journal_writer.cpp leaderboard.cpp mapped_file.cpp notification_queue.cpp object.cpp professor.cpp rw_lock.cpp score_kernels.cpp score_ranking.cpp session_client.cpp session_server.cpp shard_executor.cpp student.cpp symbol_table.cpp university_system.cpp user.cpp
\ No newline at end of file
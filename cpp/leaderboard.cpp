@@ -0,0 +1,34 @@
+#include "leaderboard.h"
+
+using namespace std;
+
+void Leaderboard::recordGrade(int studentId, double previous, double grade) {
+    auto it = entries.find(studentId);
+    if (it == entries.end()) {
+        it = entries.emplace(studentId, Entry()).first;
+    } else {
+        ranking.erase({it->second.average(), studentId});
+    }
+    
+    Entry& entry = it->second;
+    if (previous >= 0) {
+        entry.sum += grade - previous;
+    } else {
+        entry.sum += grade;
+        entry.count++;
+    }
+    ranking.insert({entry.average(), studentId});
+}
+
+void Leaderboard::clear() {
+    entries.clear();
+    ranking.clear();
+}
+
+vector<pair<int, double>> Leaderboard::top(size_t k) const {
+    vector<pair<int, double>> result;
+    for (auto it = ranking.begin(); it != ranking.end() && result.size() < k; ++it) {
+        result.emplace_back(it->second, it->first);
+    }
+    return result;
+}
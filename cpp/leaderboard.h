@@ -0,0 +1,38 @@
+#pragma once
+#include <set>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+using namespace std;
+
+// РЕЙТИНГ СТУДЕНТОВ ПО СРЕДНЕМУ БАЛЛУ
+// Сумма и количество оценок студента обновляются при каждой оценке, а упорядоченное
+// множество (средний балл, ID) держит студентов от лучшего к худшему. Первые K
+// читаются с начала множества, без обхода предметов и журналов оценок.
+class Leaderboard {
+private:
+    struct Entry {
+        double sum = 0;   // Сумма оценок
+        int count = 0;    // Количество оценок
+        double average() const { return count > 0 ? sum / count : 0.0; }
+    };
+    
+    // Больший средний балл первым, при равенстве - меньший ID
+    struct BetterFirst {
+        bool operator()(const pair<double, int>& a, const pair<double, int>& b) const {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        }
+    };
+    
+    unordered_map<int, Entry> entries;            // Сумма и количество по ID студента
+    set<pair<double, int>, BetterFirst> ranking;  // (средний балл, ID) от лучшего к худшему
+
+public:
+    // Учесть оценку; previous < 0 - оценки за этот элемент раньше не было, иначе она заменяется
+    void recordGrade(int studentId, double previous, double grade);
+    void clear();
+    
+    vector<pair<int, double>> top(size_t k) const;  // Первые k студентов: (ID, средний балл)
+    size_t size() const { return ranking.size(); }
+};
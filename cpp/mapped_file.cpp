@@ -0,0 +1,110 @@
+#include "mapped_file.h"
+#include <fstream>
+#include <sstream>
+#include <charconv>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAS_MMAP 1
+#endif
+
+using namespace std;
+
+MappedFile::MappedFile(const string& path)
+    : data(nullptr), size(0), mapped(false), opened(false) {
+#ifdef HAS_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat st;
+    bool statOk = fstat(fd, &st) == 0;
+    if (statOk && st.st_size > 0) {
+        void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr != MAP_FAILED) {
+            madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(ptr);
+            size = st.st_size;
+            mapped = true;
+        }
+    }
+    close(fd);
+
+    // Пустой файл отображать нечего
+    if (mapped || (statOk && st.st_size == 0)) {
+        opened = true;
+        return;
+    }
+#endif
+    // Запасной вариант: читаем файл в буфер целиком
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+    opened = true;
+    stringstream ss;
+    ss << file.rdbuf();
+    buffer = ss.str();
+    data = buffer.data();
+    size = buffer.size();
+}
+
+MappedFile::~MappedFile() {
+#ifdef HAS_MMAP
+    if (mapped) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+bool LineReader::next(string_view& line) {
+    if (rest.empty()) {
+        return false;
+    }
+
+    size_t end = rest.find('\n');
+    if (end == string_view::npos) {
+        line = rest;
+        rest = string_view();
+    } else {
+        line = rest.substr(0, end);
+        rest.remove_prefix(end + 1);
+    }
+    lineNumber++;
+    return true;
+}
+
+void splitFields(string_view line, vector<string_view>& fields) {
+    fields.clear();
+    while (!line.empty()) {
+        size_t comma = line.find(',');
+        if (comma == string_view::npos) {
+            fields.push_back(line);
+            break;
+        }
+        fields.push_back(line.substr(0, comma));
+        line.remove_prefix(comma + 1);
+    }
+}
+
+bool parseInt(string_view field, int& value) {
+    const char* end = field.data() + field.size();
+    auto result = from_chars(field.data(), end, value);
+    return result.ec == errc() && result.ptr == end;
+}
+
+bool parseInt(string_view field, long long& value) {
+    const char* end = field.data() + field.size();
+    auto result = from_chars(field.data(), end, value);
+    return result.ec == errc() && result.ptr == end;
+}
+
+bool parseDouble(string_view field, double& value) {
+    const char* end = field.data() + field.size();
+    auto result = from_chars(field.data(), end, value);
+    return result.ec == errc() && result.ptr == end;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// КЛАСС ОТОБРАЖЕННОГО В ПАМЯТЬ ФАЙЛА
+// Файл данных отображается целиком (mmap), строки и поля разбираются
+// как срезы string_view без промежуточных копий
+class MappedFile {
+private:
+    const char* data;      // Начало содержимого файла
+    size_t size;           // Размер содержимого
+    bool mapped;           // true - память получена через mmap
+    bool opened;           // Файл успешно открыт
+    string buffer;         // Содержимое файла, если mmap недоступен
+
+public:
+    explicit MappedFile(const string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    string_view getContents() const { return string_view(data, size); }
+};
+
+// ПОСТРОЧНЫЙ РАЗБОР СОДЕРЖИМОГО ФАЙЛА
+class LineReader {
+private:
+    string_view rest;      // Еще не прочитанная часть файла
+    size_t lineNumber;     // Номер последней прочитанной строки
+
+public:
+    explicit LineReader(string_view contents) : rest(contents), lineNumber(0) {}
+
+    bool next(string_view& line);                   // Следующая строка без '\n'
+    size_t getLineNumber() const { return lineNumber; }
+};
+
+// Разбить строку по запятым (пустое поле в конце строки не возвращается, как у getline)
+void splitFields(string_view line, vector<string_view>& fields);
+
+// Преобразование полей без исключений: false, если поле не число целиком
+bool parseInt(string_view field, int& value);
+bool parseInt(string_view field, long long& value);
+bool parseDouble(string_view field, double& value);
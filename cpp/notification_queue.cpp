@@ -0,0 +1,125 @@
+#include "notification_queue.h"
+#include <algorithm>
+
+using namespace std;
+
+NotificationQueue::NotificationQueue() : head(&stub), tail(&stub) {
+    consumer = thread(&NotificationQueue::run, this);
+}
+
+NotificationQueue::~NotificationQueue() {
+    {
+        lock_guard<mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    consumer.join();
+}
+
+void NotificationQueue::pushNode(Node* node) {
+    node->next.store(nullptr, memory_order_relaxed);
+    Node* previous = head.exchange(node, memory_order_acq_rel);
+    previous->next.store(node, memory_order_release);
+}
+
+NotificationQueue::Node* NotificationQueue::popNode() {
+    Node* node = tail;
+    Node* next = node->next.load(memory_order_acquire);
+    if (node == &stub) {
+        if (!next) {
+            return nullptr;
+        }
+        tail = next;
+        node = next;
+        next = next->next.load(memory_order_acquire);
+    }
+    if (next) {
+        tail = next;
+        return node;
+    }
+    // Последний узел: производитель мог уже заменить head, но еще не связать узлы
+    if (node != head.load(memory_order_acquire)) {
+        return nullptr;
+    }
+    pushNode(&stub);
+    next = node->next.load(memory_order_acquire);
+    if (next) {
+        tail = next;
+        return node;
+    }
+    return nullptr;
+}
+
+void NotificationQueue::publish(const GradeNotification& notification) {
+    Node* node = new Node;
+    node->event = notification;
+    pushNode(node);
+    // Счетчик растет после вставки: проснувшийся потребитель уже найдет узел в очереди
+    published.fetch_add(1);
+    if (sleeping.load()) {
+        // Потребитель либо еще проверяет условие под wakeMutex и увидит новый счетчик,
+        // либо уже ждет и получит сигнал - уведомление не теряется
+        lock_guard<mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+}
+
+void NotificationQueue::deliver(const GradeNotification& event) {
+    auto& inbox = inboxes[event.studentId];
+    // Переоценка того же задания заменяет прежнее уведомление: в сводке нужна последняя оценка
+    auto same = find_if(inbox.begin(), inbox.end(), [&](const GradeNotification& unread) {
+        return unread.subjectId == event.subjectId && unread.itemId == event.itemId;
+    });
+    if (same != inbox.end()) {
+        inbox.erase(same);
+    } else if (inbox.size() >= MAX_UNREAD) {
+        inbox.erase(inbox.begin());
+    }
+    inbox.push_back(event);
+}
+
+void NotificationQueue::run() {
+    while (true) {
+        vector<GradeNotification> batch;
+        while (Node* node = popNode()) {
+            batch.push_back(node->event);
+            delete node;
+        }
+        if (!batch.empty()) {
+            lock_guard<mutex> lock(inboxMutex);
+            for (const auto& event : batch) {
+                deliver(event);
+            }
+            delivered.fetch_add(batch.size(), memory_order_release);
+            deliveredCv.notify_all();
+            continue;
+        }
+        if (stopping && delivered.load() >= published.load()) {
+            break;
+        }
+        // Флаг ставится до проверки счетчиков: производитель, увеличивший счетчик после
+        // этой проверки, увидит флаг и разбудит поток под тем же мьютексом
+        unique_lock<mutex> lock(wakeMutex);
+        sleeping.store(true);
+        wake.wait(lock, [&] { return stopping.load() || delivered.load() < published.load(); });
+        sleeping.store(false);
+    }
+}
+
+void NotificationQueue::flush() {
+    size_t target = published.load();
+    unique_lock<mutex> lock(inboxMutex);
+    deliveredCv.wait(lock, [&] { return delivered.load(memory_order_acquire) >= target; });
+}
+
+vector<GradeNotification> NotificationQueue::takeUnread(int studentId) {
+    flush();
+    lock_guard<mutex> lock(inboxMutex);
+    auto it = inboxes.find(studentId);
+    if (it == inboxes.end()) {
+        return {};
+    }
+    vector<GradeNotification> unread = move(it->second);
+    inboxes.erase(it);
+    return unread;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "symbol_table.h"
+
+using namespace std;
+
+// УВЕДОМЛЕНИЕ ОБ ОЦЕНКЕ
+struct GradeNotification {
+    int studentId;          // Кому
+    Symbol subjectId;       // Предмет (SymbolTable)
+    Symbol itemId;          // Задание или доклад (SymbolTable)
+    double grade;           // Выставленная оценка
+    long long timestamp;    // Время выставления (секунды эпохи)
+};
+
+// АСИНХРОННАЯ ДОСТАВКА УВЕДОМЛЕНИЙ
+// Оценивающий поток только кладет событие в очередь без блокировок (несколько
+// производителей, один потребитель) и сразу продолжает работу. Фоновый поток
+// разбирает очередь пачками и раскладывает события по ящикам студентов, откуда
+// они забираются при входе одной сводкой на студента.
+class NotificationQueue {
+public:
+    static const size_t MAX_UNREAD = 100;   // Непрочитанных на студента: старые вытесняются новыми
+    
+private:
+    struct Node {
+        GradeNotification event;
+        atomic<Node*> next{nullptr};
+    };
+    
+    atomic<Node*> head;                // Последний добавленный узел (производители)
+    Node* tail;                        // Следующий к разбору узел (только потребитель)
+    Node stub;                         // Заглушка, чтобы очередь не оставалась без узлов
+    atomic<size_t> published{0};       // Поставлено событий
+    atomic<size_t> delivered{0};       // Разложено по ящикам
+    atomic<bool> stopping{false};
+    atomic<bool> sleeping{false};      // Потребитель ждет на wake (производитель будит его под wakeMutex)
+    
+    mutex inboxMutex;
+    condition_variable deliveredCv;    // Потребитель разобрал очередную пачку
+    unordered_map<int, vector<GradeNotification>> inboxes;  // Непрочитанные по ID студента (не больше MAX_UNREAD)
+    
+    mutex wakeMutex;
+    condition_variable wake;           // Появились события (будит потребителя)
+    thread consumer;
+    
+    void pushNode(Node* node);         // Добавить узел (без блокировок)
+    Node* popNode();                   // Снять узел (nullptr - пусто или вставка еще не завершена)
+    void run();                        // Цикл фонового потока
+    void deliver(const GradeNotification& event);  // Положить в ящик (под inboxMutex)
+    
+public:
+    NotificationQueue();
+    ~NotificationQueue();              // Разобрать оставшееся и остановить поток
+    NotificationQueue(const NotificationQueue&) = delete;
+    NotificationQueue& operator=(const NotificationQueue&) = delete;
+    
+    void publish(const GradeNotification& notification);     // Из любого потока, без блокировок
+    void flush();                                            // Дождаться разбора всего поставленного
+    vector<GradeNotification> takeUnread(int studentId);     // Забрать непрочитанные студента
+};
@@ -4,7 +4,7 @@
 using namespace std;
 
 Subject::Subject(const string& name, const string& code, int professorId)
-    : name(name), code(code), professorId(professorId) {}
+    : name(name), id(SymbolTable::intern(name)), code(code), professorId(professorId) {}
 
 void Subject::enrollStudent(int studentId) {
     enrolledStudentIds.insert(studentId);
@@ -14,162 +14,249 @@ bool Subject::isStudentEnrolled(int studentId) const {
     return enrolledStudentIds.find(studentId) != enrolledStudentIds.end();
 }
 
-void Subject::addAssignment(const string& assignmentName) {
-    assignments.push_back(assignmentName);
+void Subject::addAssignment(Symbol assignmentId, double maxScore) {
+    SubjectItem item{SubjectItem::Kind::ASSIGNMENT, maxScore, true, false};
+    if (assignmentItems.emplace(assignmentId, item).second) {
+        assignments.push_back(assignmentId);
+    }
 }
 
-void Subject::addReport(const string& reportName) {
-    reports.push_back(reportName);
+void Subject::addReport(Symbol reportId) {
+    auto& item = reportItems[reportId];
+    if (item.active) {
+        return;
+    }
+    // Флаг graded сохраняется: повторно созданный доклад с той же темой уже оценен
+    item.kind = SubjectItem::Kind::REPORT;
+    item.maxScore = 100.0;
+    item.active = true;
+    reports.push_back(reportId);
 }
 
-bool Subject::removeReport(const string& reportName) {
-    auto it = find(reports.begin(), reports.end(), reportName);
+bool Subject::removeReport(Symbol reportId) {
+    auto itItem = reportItems.find(reportId);
+    if (itItem == reportItems.end() || !itItem->second.active) {
+        return false;
+    }
+    itItem->second.active = false;
+    
+    auto it = find(reports.begin(), reports.end(), reportId);
     if (it != reports.end()) {
         reports.erase(it);
-        return true;
     }
-    return false;
+    return true;
+}
+
+double Subject::getAssignmentMaxScore(Symbol assignmentId) const {
+    auto it = assignmentItems.find(assignmentId);
+    return it != assignmentItems.end() ? it->second.maxScore : 100.0;
+}
+
+void Subject::setAssignmentMaxScore(Symbol assignmentId, double maxScore) {
+    auto it = assignmentItems.find(assignmentId);
+    if (it != assignmentItems.end()) {
+        it->second.maxScore = maxScore;
+    }
 }
 
-void Subject::gradeAssignment(int studentId, const string& assignmentName, double grade) {
-    if (isStudentEnrolled(studentId) && hasAssignment(assignmentName)) {
-        assignmentGrades[studentId][assignmentName] = grade;
+bool Subject::isReportGraded(Symbol reportId) const {
+    auto it = reportItems.find(reportId);
+    return it != reportItems.end() && it->second.graded;
+}
+
+void Subject::markReportGraded(Symbol reportId) {
+    auto& item = reportItems[reportId];
+    item.kind = SubjectItem::Kind::REPORT;
+    item.graded = true;
+}
+
+void Subject::setAssignmentGrades(const map<int, map<string, double>>& grades) {
+    assignmentGrades.assign(grades);
+    rebuildRankings();
+}
+
+void Subject::setReportGrades(const map<int, map<string, double>>& grades) {
+    reportGrades.assign(grades);
+    for (const auto& [studentId, reportId, grade] : reportGrades.entries()) {
+        markReportGraded(reportId);
+    }
+    rebuildRankings();
+}
+
+void Subject::recordGrade(Gradebook& gradebook, unordered_map<Symbol, ScoreRanking>& rankings,
+                          int studentId, Symbol itemId, double grade) {
+    double previous = gradebook.getGrade(studentId, itemId);
+    gradebook.setGrade(studentId, itemId, grade);
+    // В рейтингах тот же float, что и в журнале, чтобы равные оценки делили место
+    double stored = gradebook.getGrade(studentId, itemId);
+    rankings[itemId].set(studentId, stored);
+    totalRanking.add(studentId, stored - (previous >= 0 ? previous : 0.0));
+}
+
+void Subject::rebuildRankings() {
+    assignmentRankings.clear();
+    reportRankings.clear();
+    totalRanking.clear();
+    for (const auto& [studentId, assignmentId, grade] : assignmentGrades.entries()) {
+        assignmentRankings[assignmentId].set(studentId, grade);
+        totalRanking.add(studentId, grade);
+    }
+    for (const auto& [studentId, reportId, grade] : reportGrades.entries()) {
+        reportRankings[reportId].set(studentId, grade);
+        totalRanking.add(studentId, grade);
     }
 }
 
-void Subject::gradeReport(int studentId, const string& reportName, double grade) {
+void Subject::gradeAssignment(int studentId, Symbol assignmentId, double grade) {
+    if (isStudentEnrolled(studentId) && hasAssignment(assignmentId)) {
+        recordGrade(assignmentGrades, assignmentRankings, studentId, assignmentId, grade);
+    }
+}
+
+void Subject::gradeReport(int studentId, Symbol reportId, double grade) {
     if (isStudentEnrolled(studentId)) {
-        reportGrades[studentId][reportName] = grade;
+        recordGrade(reportGrades, reportRankings, studentId, reportId, grade);
+        markReportGraded(reportId);
     }
 }
 
-void Subject::gradeAllReports(const string& reportName, double grade, const vector<int>& participants) {
-    if (!hasReport(reportName)) return;
+void Subject::gradeAllReports(Symbol reportId, double grade, const vector<int>& participants) {
+    if (!hasReport(reportId)) return;
+    markReportGraded(reportId);
     
     if (participants.empty()) {
         for (int studentId : enrolledStudentIds) {
-            reportGrades[studentId][reportName] = grade;
+            recordGrade(reportGrades, reportRankings, studentId, reportId, grade);
         }
     } else {
         for (int studentId : participants) {
             if (enrolledStudentIds.find(studentId) != enrolledStudentIds.end()) {
-                reportGrades[studentId][reportName] = grade;
+                recordGrade(reportGrades, reportRankings, studentId, reportId, grade);
             }
         }
     }
 }
 
-double Subject::getStudentAssignmentGrade(int studentId, const string& assignmentName) const {
-    auto itStudent = assignmentGrades.find(studentId);
-    if (itStudent != assignmentGrades.end()) {
-        auto itAssignment = itStudent->second.find(assignmentName);
-        if (itAssignment != itStudent->second.end()) {
-            return itAssignment->second;
-        }
-    }
-    return -1.0;
+const ScoreRanking* Subject::getAssignmentRanking(Symbol assignmentId) const {
+    auto it = assignmentRankings.find(assignmentId);
+    return it != assignmentRankings.end() ? &it->second : nullptr;
 }
 
-double Subject::getStudentReportGrade(int studentId, const string& reportName) const {
-    auto itStudent = reportGrades.find(studentId);
-    if (itStudent != reportGrades.end()) {
-        auto itReport = itStudent->second.find(reportName);
-        if (itReport != itStudent->second.end()) {
-            return itReport->second;
-        }
-    }
-    return -1.0;
+const ScoreRanking* Subject::getReportRanking(Symbol reportId) const {
+    auto it = reportRankings.find(reportId);
+    return it != reportRankings.end() ? &it->second : nullptr;
+}
+
+double Subject::getStudentAssignmentGrade(int studentId, Symbol assignmentId) const {
+    return assignmentGrades.getGrade(studentId, assignmentId);
+}
+
+double Subject::getStudentReportGrade(int studentId, Symbol reportId) const {
+    return reportGrades.getGrade(studentId, reportId);
 }
 
 vector<int> Subject::getEnrolledStudents() const {
     return vector<int>(enrolledStudentIds.begin(), enrolledStudentIds.end());
 }
 
-vector<string> Subject::getAssignments() const {
+vector<Symbol> Subject::getAssignments() const {
     return assignments;
 }
 
-vector<string> Subject::getReports() const {
+vector<Symbol> Subject::getReports() const {
     return reports;
 }
 
-void Subject::generateFinalReport(const map<int, string>& studentNames) const {
-    cout << "\n=== ИТОГОВЫЙ ОТЧЕТ: " << name << " (" << code << ") ===\n";
-    cout << "ID преподавателя: " << professorId << "\n";
-    cout << "Зачисленных студентов: " << enrolledStudentIds.size() << "\n";
-    cout << "==============================================\n";
+void Subject::generateFinalReport(const map<int, string>& studentNames, ostream& out) const {
+    out << "\n=== ИТОГОВЫЙ ОТЧЕТ: " << name << " (" << code << ") ===\n";
+    out << "ID преподавателя: " << professorId << "\n";
+    out << "Зачисленных студентов: " << enrolledStudentIds.size() << "\n";
+    out << "==============================================\n";
     
     for (int studentId : enrolledStudentIds) {
         auto itName = studentNames.find(studentId);
         string studentName = (itName != studentNames.end()) ? itName->second : "Неизвестный";
         
-        cout << "\nСтудент: " << studentName << " (ID: " << studentId << ")\n";
-        
-        double total = 0.0;
-        int count = 0;
+        out << "\nСтудент: " << studentName << " (ID: " << studentId << ")\n";
         
-        auto itAssignments = assignmentGrades.find(studentId);
-        if (itAssignments != assignmentGrades.end()) {
-            cout << "Оценки за задания:\n";
-            for (const auto& [assignment, grade] : itAssignments->second) {
-                cout << "  " << left << setw(20) << assignment 
-                          << ": " << right << setw(6) << fixed 
-                          << setprecision(2) << grade << "\n";
-                total += grade;
-                count++;
+        if (assignmentGrades.hasGrades(studentId)) {
+            out << "Оценки за задания:\n";
+            for (const auto& [assignment, grade] : assignmentGrades.getStudentGrades(studentId)) {
+                out << "  " << left << setw(20) << assignment 
+                         << ": " << right << setw(6) << fixed 
+                         << setprecision(2) << grade << "\n";
             }
         }
         
-        auto itReports = reportGrades.find(studentId);
-        if (itReports != reportGrades.end()) {
-            cout << "Оценки за доклады:\n";
-            for (const auto& [report, grade] : itReports->second) {
-                cout << "  " << left << setw(20) << report 
-                          << ": " << right << setw(6) << fixed 
-                          << setprecision(2) << grade << "\n";
-                total += grade;
-                count++;
+        if (reportGrades.hasGrades(studentId)) {
+            out << "Оценки за доклады:\n";
+            for (const auto& [report, grade] : reportGrades.getStudentGrades(studentId)) {
+                out << "  " << left << setw(20) << report 
+                         << ": " << right << setw(6) << fixed 
+                         << setprecision(2) << grade << "\n";
             }
         }
         
-        if (count > 0) {
-            cout << "  Среднее: " << fixed << setprecision(2) << (total / count) << "\n";
-            cout << "  Суммарное: " << fixed << setprecision(2) << total << "\n";
+        ScoreSummary summary = getStudentScoreSummary(studentId);
+        if (summary.count > 0) {
+            out << "  Среднее: " << fixed << setprecision(2) << summary.mean() << "\n";
+            out << "  Суммарное: " << fixed << setprecision(2) << summary.sum << "\n";
         } else {
-            cout << "  Нет оценок\n";
+            out << "  Нет оценок\n";
         }
     }
-    cout << "\n";
+    out << "\n";
 }
 
-bool Subject::hasAssignment(const string& assignmentName) const {
-    return find(assignments.begin(), assignments.end(), assignmentName) != assignments.end();
+bool Subject::hasAssignment(Symbol assignmentId) const {
+    return assignmentItems.find(assignmentId) != assignmentItems.end();
 }
 
-bool Subject::hasReport(const string& reportName) const {
-    return find(reports.begin(), reports.end(), reportName) != reports.end();
+bool Subject::hasReport(Symbol reportId) const {
+    auto it = reportItems.find(reportId);
+    return it != reportItems.end() && it->second.active;
 }
 
 vector<pair<string, double>> Subject::getStudentGradesSummary(int studentId) const {
     vector<pair<string, double>> result;
     
-    auto itAssignments = assignmentGrades.find(studentId);
-    if (itAssignments != assignmentGrades.end()) {
-        for (const auto& [assignment, grade] : itAssignments->second) {
-            result.emplace_back("Задание: " + assignment, grade);
-        }
+    for (const auto& [assignment, grade] : assignmentGrades.getStudentGrades(studentId)) {
+        result.emplace_back("Задание: " + assignment, grade);
     }
     
-    auto itReports = reportGrades.find(studentId);
-    if (itReports != reportGrades.end()) {
-        for (const auto& [report, grade] : itReports->second) {
-            result.emplace_back("Доклад: " + report, grade);
-        }
+    for (const auto& [report, grade] : reportGrades.getStudentGrades(studentId)) {
+        result.emplace_back("Доклад: " + report, grade);
     }
     
     return result;
 }
 
+vector<tuple<int, Symbol, double>> Subject::getAllGradeEntries() const {
+    auto entries = assignmentGrades.entries();
+    auto reportEntries = reportGrades.entries();
+    entries.insert(entries.end(), reportEntries.begin(), reportEntries.end());
+    return entries;
+}
+
+ScoreSummary Subject::getStudentScoreSummary(int studentId) const {
+    ScoreSummary summary = assignmentGrades.summarizeStudent(studentId);
+    summary.merge(reportGrades.summarizeStudent(studentId));
+    return summary;
+}
+
+ScoreSummary Subject::getScoreSummary() const {
+    ScoreSummary summary = assignmentGrades.summarizeAll();
+    summary.merge(reportGrades.summarizeAll());
+    return summary;
+}
+
+vector<size_t> Subject::getScoreHistogram(double low, double high, size_t buckets) const {
+    vector<size_t> result(buckets, 0);
+    assignmentGrades.histogram(low, high, result);
+    reportGrades.histogram(low, high, result);
+    return result;
+}
+
 Report::Report(const string& topic, const string& subjectName, int maxParticipants)
     : topic(topic), subjectName(subjectName), maxParticipants(maxParticipants), 
       isCompleted(false) {
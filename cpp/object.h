@@ -8,20 +8,43 @@
 #include <algorithm>
 #include <utility>
 #include <iomanip>
+#include <unordered_map>
+#include "gradebook.h"
+#include "score_ranking.h"
+#include "rw_lock.h"
 
 using namespace std;
 
+// МЕТАДАННЫЕ ЭЛЕМЕНТА ПРЕДМЕТА (задания или доклада)
+struct SubjectItem {
+    enum class Kind { ASSIGNMENT, REPORT } kind;  // Вид элемента
+    double maxScore;                              // Максимальный балл
+    bool active;                                  // Элемент есть в предмете (доклад удаляется после оценки)
+    bool graded;                                  // Оценки за доклад уже выставлены
+};
+
 // КЛАСС ПРЕДМЕТА
 class Subject {
 private:
     string name;                           // Название предмета
+    Symbol id;                             // Название предмета в SymbolTable
     string code;                           // Код предмета
     int professorId;                       // ID преподавателя, ведущего предмет
     set<int> enrolledStudentIds;           // ID зачисленных студентов
-    map<int, map<string, double>> assignmentGrades; // Оценки за задания
-    map<int, map<string, double>> reportGrades;     // Оценки за доклады
-    vector<string> assignments;            // Список названий заданий
-    vector<string> reports;                // Список тем докладов
+    Gradebook assignmentGrades;            // Оценки за задания
+    Gradebook reportGrades;                // Оценки за доклады
+    vector<Symbol> assignments;            // Задания в порядке создания (SymbolTable)
+    vector<Symbol> reports;                // Доклады в порядке создания (SymbolTable)
+    unordered_map<Symbol, SubjectItem> assignmentItems;  // Метаданные заданий
+    unordered_map<Symbol, SubjectItem> reportItems;      // Метаданные докладов
+    unordered_map<Symbol, ScoreRanking> assignmentRankings;  // Рейтинг по каждому заданию
+    unordered_map<Symbol, ScoreRanking> reportRankings;      // Рейтинг по каждому докладу
+    ScoreRanking totalRanking;                               // Рейтинг по сумме баллов за предмет
+    mutable RwLock mutex;                                    // Блокировка предмета (берет вызывающий код)
+    
+    void recordGrade(Gradebook& gradebook, unordered_map<Symbol, ScoreRanking>& rankings,  // Оценка в журнал
+                     int studentId, Symbol itemId, double grade);                          // и в рейтинги
+    void rebuildRankings();                                  // Пересобрать рейтинги по журналам
     
 public:
     // КОНСТРУКТОР
@@ -30,41 +53,61 @@ public:
     void enrollStudent(int studentId);                     // Зачислить студента
     bool isStudentEnrolled(int studentId) const;          // Проверить зачисление
     
-    void addAssignment(const string& assignmentName);     // Добавить задание
-    void addReport(const string& reportName);            // Добавить доклад
-    bool removeReport(const string& reportName);         // Удалить доклад
+    // Задания и доклады передаются номерами SymbolTable: название разбирается
+    // один раз у вызывающего кода, дальше сравниваются только числа
+    void addAssignment(Symbol assignmentId, double maxScore = 100.0);  // Добавить задание
+    void addReport(Symbol reportId);                     // Добавить доклад
+    bool removeReport(Symbol reportId);                  // Удалить доклад
     
     // ВЫСТАВЛЕНИЕ ОЦЕНОК
-    void gradeAssignment(int studentId, const string& assignmentName, double grade);  // Оценка за задание
-    void gradeReport(int studentId, const string& reportName, double grade);          // Оценка за доклад
-    void gradeAllReports(const string& reportName, double grade, const vector<int>& participants = {});  // Оценка всем за доклад
+    void gradeAssignment(int studentId, Symbol assignmentId, double grade);  // Оценка за задание
+    void gradeReport(int studentId, Symbol reportId, double grade);          // Оценка за доклад
+    void gradeAllReports(Symbol reportId, double grade, const vector<int>& participants = {});  // Оценка всем за доклад
     // ПОЛУЧЕНИЕ ОЦЕНОК
-    double getStudentAssignmentGrade(int studentId, const string& assignmentName) const;  // Оценка студента за задание
-    double getStudentReportGrade(int studentId, const string& reportName) const;          // Оценка студента за доклад
+    double getStudentAssignmentGrade(int studentId, Symbol assignmentId) const;  // Оценка студента за задание
+    double getStudentReportGrade(int studentId, Symbol reportId) const;          // Оценка студента за доклад
     
     vector<int> getEnrolledStudents() const;              // Список ID зачисленных студентов
-    vector<string> getAssignments() const;                // Список заданий
-    vector<string> getReports() const;                    // Список докладов
+    vector<Symbol> getAssignments() const;                // Список заданий
+    vector<Symbol> getReports() const;                    // Список докладов
     bool isProfessor(int professorId) const { return this->professorId == professorId; }  // Проверка преподавателя
     
     string getName() const { return name; }
+    Symbol getId() const { return id; }
     string getCode() const { return code; }
     int getProfessorId() const { return professorId; }
+    // Читатели предмета берут блокировку разделяемо, изменения - монопольно.
+    // Сами методы Subject не блокируют: порядок захвата задает UniversitySystem
+    RwLock& getMutex() const { return mutex; }
     
-    void generateFinalReport(const map<int, string>& studentNames) const;  // Подробный отчет по предмету
+    void generateFinalReport(const map<int, string>& studentNames, ostream& out = cout) const;  // Подробный отчет по предмету
     
-    bool hasAssignment(const string& assignmentName) const;  // Проверить наличие задания
-    bool hasReport(const string& reportName) const;          // Проверить наличие доклада
+    bool hasAssignment(Symbol assignmentId) const;           // Проверить наличие задания
+    bool hasReport(Symbol reportId) const;                   // Проверить наличие доклада
+    double getAssignmentMaxScore(Symbol assignmentId) const; // Максимальный балл (100 по умолчанию)
+    void setAssignmentMaxScore(Symbol assignmentId, double maxScore);
+    bool isReportGraded(Symbol reportId) const;              // Выставлены ли оценки за доклад
+    void markReportGraded(Symbol reportId);                  // Отметить, что за доклад выставлены оценки
     
     vector<pair<string, double>> getStudentGradesSummary(int studentId) const; // получение сводци оценок студента
-    
-    const map<int, map<string, double>>& getAllAssignmentGrades() const { return assignmentGrades; }
-    const map<int, map<string, double>>& getAllReportGrades() const { return reportGrades; }
-    void setAssignmentGrades(const map<int, map<string, double>>& grades) { assignmentGrades = grades; }
-    void setReportGrades(const map<int, map<string, double>>& grades) { reportGrades = grades; }
+    ScoreSummary getStudentScoreSummary(int studentId) const;   // Количество, сумма и разброс оценок студента
+    ScoreSummary getScoreSummary() const;                        // Сводка по всем оценкам предмета
+    vector<size_t> getScoreHistogram(double low, double high, size_t buckets) const;  // Распределение оценок
+    
+    // РЕЙТИНГИ (место, процентиль, квантили за O(log n))
+    const ScoreRanking* getAssignmentRanking(Symbol assignmentId) const;  // nullptr, если оценок нет
+    const ScoreRanking* getReportRanking(Symbol reportId) const;          // nullptr, если оценок нет
+    const ScoreRanking& getTotalRanking() const { return totalRanking; }
+    
+    vector<tuple<int, Symbol, double>> getAllGradeEntries() const;  // Все оценки (задания и доклады): студент, элемент, оценка
+    map<int, map<string, double>> getAllAssignmentGrades() const { return assignmentGrades.toMap(); }
+    map<int, map<string, double>> getAllReportGrades() const { return reportGrades.toMap(); }
+    vector<pair<string, double>> getStudentReportGrades(int studentId) const { return reportGrades.getStudentGrades(studentId); }
+    void setAssignmentGrades(const map<int, map<string, double>>& grades);
+    void setReportGrades(const map<int, map<string, double>>& grades);
     vector<int> getEnrolledStudentIds() const { return vector<int>(enrolledStudentIds.begin(), enrolledStudentIds.end()); }
-    vector<string> getAssignmentList() const { return assignments; }
-    vector<string> getReportList() const { return reports; }
+    vector<Symbol> getAssignmentList() const { return assignments; }
+    vector<Symbol> getReportList() const { return reports; }
 };
 
 // КЛАСС ЗАДАНИЯ
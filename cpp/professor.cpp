@@ -21,27 +21,29 @@ void Professor::save(ostream& file) const {
 
 shared_ptr<Subject> Professor::createSubject(const string& name, 
                                                  const string& code,
-                                                 int professorId) {
+                                                 int professorId, ostream& out) {
     auto subject = make_shared<Subject>(name, code, professorId);
-    cout << "Предмет '" << name << "' создан успешно!\n";
+    out << "Предмет '" << name << "' создан успешно!\n";
     return subject;
 }
 
 shared_ptr<Assignment> Professor::createAssignment(const string& name, 
                                                        const string& description,
-                                                       shared_ptr<Subject> subject) {
+                                                       shared_ptr<Subject> subject,
+                                                       ostream& out) {
     auto assignment = make_shared<Assignment>(name, subject->getName(), 100.0);
-    subject->addAssignment(name);
-    cout << "Задание '" << name << "' создано успешно!\n";
+    subject->addAssignment(SymbolTable::intern(name));
+    out << "Задание '" << name << "' создано успешно!\n";
     return assignment;
 }
 
 shared_ptr<Report> Professor::createReport(const string& topic, 
                                                shared_ptr<Subject> subject,
-                                               int maxParticipants) {
+                                               int maxParticipants,
+                                               ostream& out) {
     auto report = make_shared<Report>(topic, subject->getName(), maxParticipants);
-    subject->addReport(topic);
-    cout << "Доклад '" << topic << "' создан успешно!\n";
+    subject->addReport(SymbolTable::intern(topic));
+    out << "Доклад '" << topic << "' создан успешно!\n";
     return report;
 }
 
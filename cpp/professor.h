@@ -20,9 +20,11 @@ public:
     void displayInfo() const override;
     void save(ostream& file) const override;
     
-    shared_ptr<Subject> createSubject(const string& name, const string& code, int professorId);
-    shared_ptr<Assignment> createAssignment(const string& name, const string& description, shared_ptr<Subject> subject);
-    shared_ptr<Report> createReport(const string& topic, shared_ptr<Subject> subject, int maxParticipants = 5);
+    shared_ptr<Subject> createSubject(const string& name, const string& code, int professorId, ostream& out = cout);
+    shared_ptr<Assignment> createAssignment(const string& name, const string& description, shared_ptr<Subject> subject,
+                                            ostream& out = cout);
+    shared_ptr<Report> createReport(const string& topic, shared_ptr<Subject> subject, int maxParticipants = 5,
+                                    ostream& out = cout);
     
     static shared_ptr<Professor> create(const string& name, const string& password);
     static shared_ptr<Professor> load(const string& name, const string& passwordHash, int id);
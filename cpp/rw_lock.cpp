@@ -0,0 +1,34 @@
+#include "rw_lock.h"
+
+#ifdef __linux__
+
+RwLock::RwLock() {
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+    pthread_rwlock_init(&handle, &attr);
+    pthread_rwlockattr_destroy(&attr);
+}
+
+RwLock::~RwLock() { pthread_rwlock_destroy(&handle); }
+
+void RwLock::lock() { pthread_rwlock_wrlock(&handle); }
+bool RwLock::try_lock() { return pthread_rwlock_trywrlock(&handle) == 0; }
+void RwLock::unlock() { pthread_rwlock_unlock(&handle); }
+void RwLock::lock_shared() { pthread_rwlock_rdlock(&handle); }
+bool RwLock::try_lock_shared() { return pthread_rwlock_tryrdlock(&handle) == 0; }
+void RwLock::unlock_shared() { pthread_rwlock_unlock(&handle); }
+
+#else
+
+RwLock::RwLock() {}
+RwLock::~RwLock() {}
+
+void RwLock::lock() { handle.lock(); }
+bool RwLock::try_lock() { return handle.try_lock(); }
+void RwLock::unlock() { handle.unlock(); }
+void RwLock::lock_shared() { handle.lock_shared(); }
+bool RwLock::try_lock_shared() { return handle.try_lock_shared(); }
+void RwLock::unlock_shared() { handle.unlock_shared(); }
+
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+#include <shared_mutex>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+using namespace std;
+
+// БЛОКИРОВКА ЧИТАТЕЛЕЙ И ПИСАТЕЛЕЙ С ПРИОРИТЕТОМ ПИСАТЕЛЕЙ
+// shared_mutex в glibc пропускает новых читателей, пока хоть один читатель внутри,
+// поэтому при постоянном потоке чтений оценка и контрольная точка ждут бесконечно.
+// Здесь ожидающий писатель закрывает вход новым читателям: чтения идут параллельно,
+// но уже начатые ждут не дольше одной мутации. Подходит для shared_lock и unique_lock.
+// Повторный разделяемый захват в одном потоке запрещен (возможна взаимоблокировка).
+class RwLock {
+private:
+#ifdef __linux__
+    pthread_rwlock_t handle;
+#else
+    shared_mutex handle;               // Запасной вариант: порядок определяет стандартная библиотека
+#endif
+
+public:
+    RwLock();
+    ~RwLock();
+    RwLock(const RwLock&) = delete;
+    RwLock& operator=(const RwLock&) = delete;
+
+    void lock();                       // Монопольный захват (писатель)
+    bool try_lock();
+    void unlock();
+    void lock_shared();                // Разделяемый захват (читатель)
+    bool try_lock_shared();
+    void unlock_shared();
+};
@@ -0,0 +1,293 @@
+#include "score_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAS_X86_KERNELS 1
+#endif
+
+using namespace std;
+
+void ScoreSummary::merge(const ScoreSummary& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0 || other.min < min) {
+        min = other.min;
+    }
+    if (count == 0 || other.max > max) {
+        max = other.max;
+    }
+    count += other.count;
+    sum += other.sum;
+    sumSquares += other.sumSquares;
+}
+
+double ScoreSummary::variance() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    double m = mean();
+    return std::max(0.0, sumSquares / count - m * m);
+}
+
+namespace {
+
+// Слово маски с отброшенными битами за пределами n
+uint64_t maskWord(const uint64_t* validMask, size_t word, size_t n) {
+    size_t base = word * 64;
+    uint64_t bits = validMask[word];
+    if (n - base < 64) {
+        bits &= (uint64_t(1) << (n - base)) - 1;
+    }
+    return bits;
+}
+
+size_t bucketOf(double score, double low, double width, size_t buckets) {
+    if (!(score > low)) {
+        return 0;
+    }
+    size_t bucket = static_cast<size_t>((score - low) / width);
+    return min(bucket, buckets - 1);
+}
+
+// Выставленные оценки одного слова маски по одной (скалярный хвост и запасной вариант)
+void summarizeBits(const float* scores, uint64_t bits, ScoreSummary& summary) {
+    while (bits) {
+        double score = scores[__builtin_ctzll(bits)];
+        bits &= bits - 1;
+        if (summary.count == 0 || score < summary.min) {
+            summary.min = score;
+        }
+        if (summary.count == 0 || score > summary.max) {
+            summary.max = score;
+        }
+        summary.count++;
+        summary.sum += score;
+        summary.sumSquares += score * score;
+    }
+}
+
+ScoreSummary summarizeScalar(const float* scores, const uint64_t* validMask, size_t n) {
+    ScoreSummary summary;
+    for (size_t word = 0; word * 64 < n; word++) {
+        summarizeBits(scores + word * 64, maskWord(validMask, word, n), summary);
+    }
+    return summary;
+}
+
+void histogramScalar(const float* scores, const uint64_t* validMask, size_t n,
+                     double low, double width, vector<size_t>& buckets) {
+    for (size_t word = 0; word * 64 < n; word++) {
+        uint64_t bits = maskWord(validMask, word, n);
+        while (bits) {
+            double score = scores[word * 64 + __builtin_ctzll(bits)];
+            bits &= bits - 1;
+            buckets[bucketOf(score, low, width, buckets.size())]++;
+        }
+    }
+}
+
+#ifdef HAS_X86_KERNELS
+
+// SSE2: по 4 оценки за шаг, сумма и сумма квадратов накапливаются в double
+ScoreSummary summarizeSse2(const float* scores, const uint64_t* validMask, size_t n) {
+    const __m128i lanes = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128 posInf = _mm_set1_ps(INFINITY);
+    const __m128 negInf = _mm_set1_ps(-INFINITY);
+    __m128d sum = _mm_setzero_pd();
+    __m128d sumSquares = _mm_setzero_pd();
+    __m128 minimum = posInf;
+    __m128 maximum = negInf;
+    size_t count = 0;
+    ScoreSummary tail;
+
+    for (size_t word = 0; word * 64 < n; word++) {
+        uint64_t bits = maskWord(validMask, word, n);
+        if (bits == 0) {
+            continue;
+        }
+        const float* block = scores + word * 64;
+        size_t length = min<size_t>(64, n - word * 64);
+        size_t i = 0;
+        for (; i + 4 <= length; i += 4) {
+            int nibble = (bits >> i) & 0xF;
+            if (nibble == 0) {
+                continue;
+            }
+            count += __builtin_popcount(nibble);
+            __m128 valid = _mm_castsi128_ps(_mm_cmpeq_epi32(
+                _mm_and_si128(_mm_set1_epi32(nibble), lanes), lanes));
+            __m128 values = _mm_and_ps(_mm_loadu_ps(block + i), valid);
+            minimum = _mm_min_ps(minimum, _mm_or_ps(values, _mm_andnot_ps(valid, posInf)));
+            maximum = _mm_max_ps(maximum, _mm_or_ps(values, _mm_andnot_ps(valid, negInf)));
+            __m128d low = _mm_cvtps_pd(values);
+            __m128d high = _mm_cvtps_pd(_mm_movehl_ps(values, values));
+            sum = _mm_add_pd(sum, _mm_add_pd(low, high));
+            sumSquares = _mm_add_pd(sumSquares, _mm_add_pd(_mm_mul_pd(low, low), _mm_mul_pd(high, high)));
+        }
+        summarizeBits(block, i < 64 ? bits & ~((uint64_t(1) << i) - 1) : 0, tail);
+    }
+
+    ScoreSummary summary;
+    if (count > 0) {
+        alignas(16) float mins[4], maxs[4];
+        alignas(16) double sums[2], squares[2];
+        _mm_store_ps(mins, minimum);
+        _mm_store_ps(maxs, maximum);
+        _mm_store_pd(sums, sum);
+        _mm_store_pd(squares, sumSquares);
+        summary.count = count;
+        summary.sum = sums[0] + sums[1];
+        summary.sumSquares = squares[0] + squares[1];
+        summary.min = *min_element(mins, mins + 4);
+        summary.max = *max_element(maxs, maxs + 4);
+    }
+    summary.merge(tail);
+    return summary;
+}
+
+// AVX2: по 8 оценок за шаг, маска шага строится из байта слова маски
+__attribute__((target("avx2")))
+ScoreSummary summarizeAvx2(const float* scores, const uint64_t* validMask, size_t n) {
+    const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256 posInf = _mm256_set1_ps(INFINITY);
+    const __m256 negInf = _mm256_set1_ps(-INFINITY);
+    __m256d sum = _mm256_setzero_pd();
+    __m256d sumSquares = _mm256_setzero_pd();
+    __m256 minimum = posInf;
+    __m256 maximum = negInf;
+    size_t count = 0;
+
+    for (size_t word = 0; word * 64 < n; word++) {
+        uint64_t bits = maskWord(validMask, word, n);
+        if (bits == 0) {
+            continue;
+        }
+        const float* block = scores + word * 64;
+        size_t length = min<size_t>(64, n - word * 64);
+        for (size_t i = 0; i < length; i += 8) {
+            int byte = (bits >> i) & 0xFF;
+            if (byte == 0) {
+                continue;
+            }
+            count += __builtin_popcount(byte);
+            __m256i validLanes = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(byte), lanes), lanes);
+            __m256 valid = _mm256_castsi256_ps(validLanes);
+            // Неполный хвост читается маскированной загрузкой, чтобы не выйти за массив
+            __m256 values = i + 8 <= length ? _mm256_and_ps(_mm256_loadu_ps(block + i), valid)
+                                            : _mm256_maskload_ps(block + i, validLanes);
+            minimum = _mm256_min_ps(minimum, _mm256_blendv_ps(posInf, values, valid));
+            maximum = _mm256_max_ps(maximum, _mm256_blendv_ps(negInf, values, valid));
+            __m256d low = _mm256_cvtps_pd(_mm256_castps256_ps128(values));
+            __m256d high = _mm256_cvtps_pd(_mm256_extractf128_ps(values, 1));
+            sum = _mm256_add_pd(sum, _mm256_add_pd(low, high));
+            sumSquares = _mm256_add_pd(sumSquares,
+                _mm256_add_pd(_mm256_mul_pd(low, low), _mm256_mul_pd(high, high)));
+        }
+    }
+
+    ScoreSummary summary;
+    if (count > 0) {
+        alignas(32) float mins[8], maxs[8];
+        alignas(32) double sums[4], squares[4];
+        _mm256_store_ps(mins, minimum);
+        _mm256_store_ps(maxs, maximum);
+        _mm256_store_pd(sums, sum);
+        _mm256_store_pd(squares, sumSquares);
+        summary.count = count;
+        summary.sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        summary.sumSquares = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+        summary.min = *min_element(mins, mins + 8);
+        summary.max = *max_element(maxs, maxs + 8);
+    }
+    _mm256_zeroupper();
+    return summary;
+}
+
+// Номера корзин считаются по 8 за шаг, счетчики увеличиваются по маске
+__attribute__((target("avx2")))
+void histogramAvx2(const float* scores, const uint64_t* validMask, size_t n,
+                   double lowBound, double width, vector<size_t>& buckets) {
+    const __m256d base = _mm256_set1_pd(lowBound);
+    const __m256d step = _mm256_set1_pd(width);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d last = _mm256_set1_pd(static_cast<double>(buckets.size() - 1));
+    const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    alignas(32) int indexes[8];
+
+    for (size_t word = 0; word * 64 < n; word++) {
+        uint64_t bits = maskWord(validMask, word, n);
+        if (bits == 0) {
+            continue;
+        }
+        const float* block = scores + word * 64;
+        size_t length = min<size_t>(64, n - word * 64);
+        for (size_t i = 0; i < length; i += 8) {
+            unsigned byte = (bits >> i) & 0xFF;
+            if (byte == 0) {
+                continue;
+            }
+            __m256i validLanes = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(byte), lanes), lanes);
+            __m256 values = i + 8 <= length ? _mm256_loadu_ps(block + i)
+                                            : _mm256_maskload_ps(block + i, validLanes);
+            __m256d low = _mm256_div_pd(_mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(values)), base), step);
+            __m256d high = _mm256_div_pd(_mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)), base), step);
+            low = _mm256_min_pd(_mm256_max_pd(low, zero), last);
+            high = _mm256_min_pd(_mm256_max_pd(high, zero), last);
+            _mm_store_si128(reinterpret_cast<__m128i*>(indexes), _mm256_cvttpd_epi32(low));
+            _mm_store_si128(reinterpret_cast<__m128i*>(indexes + 4), _mm256_cvttpd_epi32(high));
+            while (byte) {
+                buckets[indexes[__builtin_ctz(byte)]]++;
+                byte &= byte - 1;
+            }
+        }
+    }
+    _mm256_zeroupper();
+}
+
+#endif
+
+struct ScoreKernels {
+    const char* name;
+    ScoreSummary (*summarize)(const float*, const uint64_t*, size_t);
+    void (*histogram)(const float*, const uint64_t*, size_t, double, double, vector<size_t>&);
+};
+
+ScoreKernels selectKernels() {
+#ifdef HAS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", summarizeAvx2, histogramAvx2};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return {"sse2", summarizeSse2, histogramScalar};
+    }
+#endif
+    return {"scalar", summarizeScalar, histogramScalar};
+}
+
+const ScoreKernels& kernels() {
+    static const ScoreKernels selected = selectKernels();
+    return selected;
+}
+
+}
+
+ScoreSummary summarizeScores(const float* scores, const uint64_t* validMask, size_t n) {
+    return kernels().summarize(scores, validMask, n);
+}
+
+void histogramScores(const float* scores, const uint64_t* validMask, size_t n,
+                     double low, double high, vector<size_t>& buckets) {
+    if (buckets.empty() || n == 0) {
+        return;
+    }
+    double width = high > low ? (high - low) / buckets.size() : 1.0;
+    kernels().histogram(scores, validMask, n, low, width, buckets);
+}
+
+const char* scoreKernelName() {
+    return kernels().name;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// СВОДКА ПО НАБОРУ ОЦЕНОК
+struct ScoreSummary {
+    size_t count = 0;         // Количество оценок
+    double sum = 0;           // Сумма
+    double min = 0;           // Минимум (при count > 0)
+    double max = 0;           // Максимум (при count > 0)
+    double sumSquares = 0;    // Сумма квадратов
+
+    void merge(const ScoreSummary& other);        // Объединить со сводкой другого участка
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+    double variance() const;                      // Дисперсия (генеральная)
+};
+
+// ВЕКТОРНЫЕ ЯДРА АГРЕГАЦИИ ОЦЕНОК
+// Работают по непрерывному массиву оценок с битовой маской: бит i слова i / 64
+// означает, что оценка i выставлена. Реализация (AVX2, SSE2 или скалярная)
+// выбирается один раз при первом вызове по возможностям процессора.
+
+// Количество, сумма, минимум, максимум и сумма квадратов выставленных оценок
+ScoreSummary summarizeScores(const float* scores, const uint64_t* validMask, size_t n);
+
+// Добавить выставленные оценки в гистограмму: buckets.size() равных корзин на [low, high],
+// значения за границами попадают в крайние корзины
+void histogramScores(const float* scores, const uint64_t* validMask, size_t n,
+                     double low, double high, vector<size_t>& buckets);
+
+const char* scoreKernelName();   // "avx2", "sse2" или "scalar"
@@ -0,0 +1,75 @@
+#include "score_ranking.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void ScoreRanking::set(int studentId, double score) {
+    auto it = scoreOf.find(studentId);
+    if (it != scoreOf.end()) {
+        ordered.erase({it->second, studentId});
+        it->second = score;
+    } else {
+        scoreOf.emplace(studentId, score);
+    }
+    ordered.insert({score, studentId});
+}
+
+void ScoreRanking::add(int studentId, double delta) {
+    auto it = scoreOf.find(studentId);
+    set(studentId, (it != scoreOf.end() ? it->second : 0.0) + delta);
+}
+
+void ScoreRanking::erase(int studentId) {
+    auto it = scoreOf.find(studentId);
+    if (it == scoreOf.end()) {
+        return;
+    }
+    ordered.erase({it->second, studentId});
+    scoreOf.erase(it);
+}
+
+void ScoreRanking::clear() {
+    ordered.clear();
+    scoreOf.clear();
+}
+
+double ScoreRanking::score(int studentId) const {
+    auto it = scoreOf.find(studentId);
+    return it != scoreOf.end() ? it->second : -1.0;
+}
+
+int ScoreRanking::rank(int studentId) const {
+    auto it = scoreOf.find(studentId);
+    if (it == scoreOf.end()) {
+        return 0;
+    }
+    return static_cast<int>(ordered.size() - countAtOrBelow(it->second)) + 1;
+}
+
+double ScoreRanking::percentile(int studentId) const {
+    auto it = scoreOf.find(studentId);
+    if (it == scoreOf.end()) {
+        return 0.0;
+    }
+    return 100.0 * countAtOrBelow(it->second) / ordered.size();
+}
+
+double ScoreRanking::kth(size_t k) const {
+    if (k >= ordered.size()) {
+        return -1.0;
+    }
+    return ordered.find_by_order(ordered.size() - 1 - k)->first;
+}
+
+double ScoreRanking::quantile(double q) const {
+    if (ordered.empty()) {
+        return 0.0;
+    }
+    double position = clamp(q, 0.0, 1.0) * (ordered.size() - 1);
+    size_t lower = static_cast<size_t>(floor(position));
+    size_t upper = static_cast<size_t>(ceil(position));
+    double low = ordered.find_by_order(lower)->first;
+    double high = ordered.find_by_order(upper)->first;
+    return low + (high - low) * (position - lower);
+}
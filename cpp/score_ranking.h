@@ -0,0 +1,39 @@
+#pragma once
+#include <unordered_map>
+#include <utility>
+#include <climits>
+#include <ext/pb_ds/assoc_container.hpp>
+#include <ext/pb_ds/tree_policy.hpp>
+
+using namespace std;
+
+// РЕЙТИНГ ОЦЕНОК (дерево порядковых статистик)
+// Хранит пары (балл, ID студента) в красно-черном дереве, где каждый узел знает
+// размер своего поддерева. Место студента, процентиль и k-я по величине оценка
+// находятся за O(log n), без копирования и сортировки оценок.
+class ScoreRanking {
+private:
+    using OrderedScores = __gnu_pbds::tree<pair<double, int>, __gnu_pbds::null_type, less<pair<double, int>>,
+                                           __gnu_pbds::rb_tree_tag, __gnu_pbds::tree_order_statistics_node_update>;
+
+    OrderedScores ordered;                 // (балл, ID студента) по возрастанию
+    unordered_map<int, double> scoreOf;    // Текущий балл студента
+
+    size_t countAtOrBelow(double score) const { return ordered.order_of_key({score, INT_MAX}); }
+
+public:
+    void set(int studentId, double score);    // Выставить или заменить балл студента
+    void add(int studentId, double delta);    // Прибавить к баллу студента (0, если его не было)
+    void erase(int studentId);                // Убрать студента из рейтинга
+    void clear();
+
+    size_t size() const { return ordered.size(); }
+    bool contains(int studentId) const { return scoreOf.count(studentId) > 0; }
+    double score(int studentId) const;        // Балл студента или -1.0, если его нет
+
+    int rank(int studentId) const;            // Место (1 - лучший, равные баллы делят место) или 0
+    double percentile(int studentId) const;   // Доля баллов не выше балла студента, в процентах
+    double kth(size_t k) const;               // k-й балл по убыванию (0 - лучший)
+    double quantile(double q) const;          // Квантиль q из [0, 1] с линейной интерполяцией
+    double median() const { return quantile(0.5); }
+};
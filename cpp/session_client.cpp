@@ -0,0 +1,366 @@
+#include "session_client.h"
+#include <iostream>
+#include <fstream>
+#include <cerrno>
+#include <cstring>
+#include <charconv>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define HAS_UNIX_SOCKETS 1
+#endif
+
+using namespace std;
+
+SessionClient::SessionClient(const string& socketPath) : fd(-1) {
+#ifdef HAS_UNIX_SOCKETS
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cout << "Слишком длинный путь к сокету: " << socketPath << endl;
+        return;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+    
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        fd = -1;
+    }
+    if (fd < 0) {
+        cout << "Не удалось подключиться к " << socketPath << ": " << strerror(errno) << endl;
+    }
+#else
+    cout << "Подключение к серверу поддерживается только в Linux\n";
+#endif
+}
+
+SessionClient::~SessionClient() {
+#ifdef HAS_UNIX_SOCKETS
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+}
+
+string SessionClient::request(const vector<string>& fields, string& body) {
+#ifdef HAS_UNIX_SOCKETS
+    string line;
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (i > 0) line += '\t';
+        line += fields[i];
+    }
+    line += '\n';
+    
+    for (size_t sent = 0; sent < line.size();) {
+        ssize_t n = write(fd, line.data() + sent, line.size() - sent);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return "";
+        sent += n;
+    }
+    
+    // Ответ: "СТАТУС ДЛИНА\n" и ДЛИНА байт текста
+    char buffer[4096];
+    size_t header;
+    size_t length = 0;
+    string status;
+    while (true) {
+        header = received.find('\n');
+        if (header != string::npos && status.empty()) {
+            size_t space = received.find(' ');
+            if (space == string::npos || space > header) return "";
+            // Длина без пробелов и знака, до конца строки заголовка; иначе ответ испорчен
+            const char* first = received.data() + space + 1;
+            const char* last = received.data() + header;
+            auto [end, error] = from_chars(first, last, length);
+            if (first == last || error != errc() || end != last) return "";
+            status = received.substr(0, space);
+        }
+        if (!status.empty() && received.size() >= header + 1 + length) {
+            break;
+        }
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return "";
+        received.append(buffer, n);
+    }
+    body = received.substr(header + 1, length);
+    received.erase(0, header + 1 + length);
+    return status;
+#else
+    (void)fields;
+    (void)body;
+    return "";
+#endif
+}
+
+string SessionClient::upload(const string& path, const string& command) {
+    // Файл читает клиент: сервер не открывает пути, присланные по сети
+    ifstream file(path);
+    if (!file) {
+        cout << "Не удалось открыть файл: " << path << endl;
+        return "ERR";
+    }
+    string line;
+    while (getline(file, line)) {
+        string status = call({"IMPORT_LINE", line});
+        if (status != "OK") {
+            return status;
+        }
+    }
+    return call({command});
+}
+
+string SessionClient::call(const vector<string>& fields) {
+    string body;
+    string status = request(fields, body);
+    cout << body;
+    if (status.empty()) {
+        cout << "\nСоединение с сервером потеряно.\n";
+    }
+    return status;
+}
+
+bool SessionClient::readLine(const string& prompt, string& value) {
+    cout << prompt;
+    return static_cast<bool>(getline(cin, value));
+}
+
+bool SessionClient::readNumber(const string& prompt, string& value) {
+    cout << prompt;
+    if (!(cin >> value)) {
+        return false;
+    }
+    cin.ignore();
+    return true;
+}
+
+void SessionClient::run() {
+    while (isConnected()) {
+        cout << "\n=== УНИВЕРСИТЕТСКАЯ СИСТЕМА ===\n";
+        cout << "1. Вход\n";
+        cout << "2. Регистрация\n";
+        cout << "3. Выход\n";
+        
+        string choice, name, password;
+        if (!readNumber("Выберите действие: ", choice)) return;
+        
+        if (choice == "1") {
+            if (!readLine("Имя: ", name) || !readLine("Пароль: ", password)) return;
+            string status = call({"LOGIN", name, password});
+            if (status.empty()) return;
+            if (status != "OK") continue;
+            
+            string role;
+            if (request({"ROLE"}, role).empty()) return;
+            if (role == "student") {
+                runStudentMenu();
+            } else {
+                runProfessorMenu();
+            }
+        } else if (choice == "2") {
+            if (!readLine("Имя: ", name) || !readLine("Пароль: ", password)) return;
+            cout << "Выберите роль:\n";
+            cout << "1. Студент\n";
+            cout << "2. Преподаватель\n";
+            string role;
+            if (!readNumber("Выбор: ", role)) return;
+            if (call({"REGISTER", name, password, role}).empty()) return;
+        } else if (choice == "3") {
+            cout << "До свидания!\n";
+            return;
+        } else {
+            cout << "Неверный выбор!\n";
+        }
+    }
+}
+
+void SessionClient::runStudentMenu() {
+    while (true) {
+        cout << "\n=== МЕНЮ СТУДЕНТА ===\n";
+        cout << "1. Просмотреть мои предметы\n";
+        cout << "2. Сдать задание\n";
+        cout << "3. Записаться на доклад\n";
+        cout << "4. Отказаться от доклада\n";
+        cout << "5. Посмотреть мои оценки по предметам\n";
+        cout << "6. Выход из системы\n";
+        
+        string choice, identifier, value, status;
+        if (!readNumber("Выберите действие: ", choice)) return;
+        
+        if (choice == "1") {
+            status = call({"MY_SUBJECTS"});
+        } else if (choice == "2") {
+            string subjects;
+            status = request({"MY_SUBJECTS"}, subjects);
+            if (status == "OK") {
+                // Тот же список, что и в пункте 1, но с заголовком меню сдачи
+                cout << "Ваши предметы:\n" << subjects.substr(subjects.find('\n') + 1);
+                if (!readLine("Введите название предмета или код (например: $100): ", identifier)) return;
+                status = call({"SUBJECT_ASSIGNMENTS", identifier});
+                if (status == "OK") {
+                    if (!readLine("Введите название задания: ", value)) return;
+                    status = call({"SUBMIT", identifier, value});
+                }
+            } else {
+                cout << subjects;
+            }
+        } else if (choice == "3") {
+            status = call({"AVAILABLE_REPORTS"});
+            if (status == "OK") {
+                if (!readNumber("Выберите номер доклада: ", value)) return;
+                status = call({"JOIN_REPORT", value});
+            }
+        } else if (choice == "4") {
+            if (!readLine("Введите тему доклада: ", value)) return;
+            status = call({"LEAVE_REPORT", value});
+        } else if (choice == "5") {
+            status = call({"SUMMARY"});
+        } else if (choice == "6") {
+            call({"LOGOUT"});
+            return;
+        } else {
+            cout << "Неверный выбор!\n";
+            continue;
+        }
+        if (status.empty()) return;
+    }
+}
+
+void SessionClient::runProfessorMenu() {
+    // Список предметов преподавателя; false - предметов нет или связь потеряна
+    auto showSubjects = [this](bool& connected) {
+        string body;
+        string status = request({"PROF_SUBJECTS"}, body);
+        connected = !status.empty();
+        cout << body;
+        return status == "OK";
+    };
+    
+    while (true) {
+        cout << "\n=== МЕНЮ ПРЕПОДАВАТЕЛЯ ===\n";
+        cout << "Ваши предметы:\n";
+        bool connected = true;
+        if (!showSubjects(connected)) {
+            if (!connected) return;
+            cout << "  (нет предметов)\n";
+        }
+        
+        cout << "\n1. Создать предмет\n";
+        cout << "2. Создать задание\n";
+        cout << "3. Создать доклад\n";
+        cout << "4. Записать студента на предмет\n";
+        cout << "5. Проверить сданные работы\n";
+        cout << "6. Выставить оценку за доклад\n";
+        cout << "7. Просмотреть статистику предмета\n";
+        cout << "8. Создать итоговый отчет\n";
+        cout << "9. Рейтинг студента по предмету\n";
+        cout << "10. Лучшие студенты\n";
+        cout << "11. Импорт оценок из CSV\n";
+        cout << "12. Импорт списка студентов\n";
+        cout << "13. Выход из системы\n";
+        
+        string choice, identifier, name, value, status = "OK";
+        if (!readNumber("Выберите действие: ", choice)) return;
+        
+        // Пункты 2-4, 7 и 8 сначала показывают предметы преподавателя
+        if (choice == "2" || choice == "3" || choice == "4" || choice == "7" || choice == "8") {
+            cout << "Ваши предметы:\n";
+            if (!showSubjects(connected)) {
+                if (!connected) return;
+                cout << (choice == "7" || choice == "8" ? "У вас нет предметов.\n"
+                                                        : "У вас нет предметов. Сначала создайте предмет.\n");
+                continue;
+            }
+        }
+        
+        if (choice == "1") {
+            string code;
+            if (!readLine("Название предмета: ", name) || !readLine("Код предмета: ", code)) return;
+            status = call({"CREATE_SUBJECT", name, code});
+            if (status == "CONFIRM") {
+                cout << "1. Да, заменить преподавателя\n";
+                cout << "2. Нет, отменить создание\n";
+                if (!readNumber("Выберите: ", value)) return;
+                if (value == "1") {
+                    status = call({"CREATE_SUBJECT", name, code, "replace"});
+                } else {
+                    cout << "Создание предмета отменено.\n";
+                }
+            }
+        } else if (choice == "2") {
+            if (!readLine("Введите название предмета или код: ", identifier) ||
+                !readLine("Название задания: ", name) ||
+                !readNumber("Максимальный балл: ", value)) return;
+            status = call({"CREATE_ASSIGNMENT", identifier, name, value});
+        } else if (choice == "3") {
+            if (!readLine("Введите название предмета или код: ", identifier) ||
+                !readLine("Тема доклада: ", name) ||
+                !readNumber("Макс. участников: ", value)) return;
+            status = call({"CREATE_REPORT", identifier, name, value});
+        } else if (choice == "4") {
+            status = call({"STUDENTS"});
+            if (status.empty() || !readNumber("Введите ID студента: ", value) ||
+                !readLine("Введите название предмета или код: ", identifier)) return;
+            status = call({"ENROLL", value, identifier});
+        } else if (choice == "5") {
+            status = call({"PENDING"});
+            if (status == "OK") {
+                string number, action;
+                if (!readNumber("\nВыберите работу для проверки (номер): ", number)) return;
+                status = call({"SUBMISSION", number});
+                if (status == "OK") {
+                    cout << "\n1. Утвердить и выставить оценку\n";
+                    cout << "2. Отклонить\n";
+                    if (!readNumber("Выберите действие: ", action)) return;
+                    if (action == "1") {
+                        if (!readNumber("Введите оценку: ", value)) return;
+                        status = call({"APPROVE", number, value});
+                    } else if (action == "2") {
+                        status = call({"REJECT", number});
+                    }
+                }
+            }
+        } else if (choice == "6") {
+            status = call({"GRADABLE_REPORTS"});
+            if (status == "OK") {
+                string number;
+                if (!readNumber("Выберите номер доклада: ", number)) return;
+                status = call({"REPORT_PARTICIPANTS", number});
+                if (status == "OK") {
+                    if (!readNumber("Введите оценку для всех участников (0-100): ", value)) return;
+                    status = call({"GRADE_REPORT", number, value});
+                }
+            }
+        } else if (choice == "7" || choice == "8") {
+            if (!readLine("Введите название предмета или код: ", identifier)) return;
+            status = call({choice == "7" ? "STATS" : "FINAL_REPORT", identifier});
+        } else if (choice == "9") {
+            if (!readLine("Введите название предмета или код: ", identifier)) return;
+            status = call({"SUBJECT_STUDENTS", identifier});
+            if (status == "OK") {
+                if (!readNumber("Введите ID студента: ", value)) return;
+                status = call({"RANKING", identifier, value});
+            }
+        } else if (choice == "10") {
+            if (!readLine("Название предмета или код (пусто - по всем предметам): ", identifier) ||
+                !readNumber("Сколько студентов показать: ", value)) return;
+            status = call({"TOP", value, identifier});
+        } else if (choice == "11") {
+            if (!readLine("Путь к CSV (студент,предмет,задание,оценка): ", value)) return;
+            status = upload(value, "IMPORT_GRADES");
+        } else if (choice == "12") {
+            if (!readLine("Путь к списку (имя,пароль[,предмет...]): ", value)) return;
+            status = upload(value, "IMPORT_ROSTER");
+        } else if (choice == "13") {
+            call({"LOGOUT"});
+            return;
+        } else {
+            cout << "Неверный выбор!\n";
+            continue;
+        }
+        if (status.empty()) return;
+    }
+}
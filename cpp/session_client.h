@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ТОНКИЙ КЛИЕНТ СЕРВЕРА СЕССИЙ
+// Показывает те же меню, что и локальный режим, но данные не загружает:
+// каждое действие уходит запросом на сервер (см. SessionServer), а текст
+// ответа печатается как есть.
+class SessionClient {
+private:
+    int fd;               // Сокет соединения с сервером (-1 - нет соединения)
+    string received;      // Принятые байты, еще не разобранные на ответы
+
+    string request(const vector<string>& fields, string& body);  // Отправить запрос, вернуть статус ("" - связь потеряна)
+    string call(const vector<string>& fields);                   // То же, с выводом текста ответа
+    string upload(const string& path, const string& command);    // Передать файл строками IMPORT_LINE и выполнить команду
+    bool readLine(const string& prompt, string& value);          // Подсказка и строка ввода
+    bool readNumber(const string& prompt, string& value);        // Подсказка и число (как cin >> в меню)
+
+    void runStudentMenu();      // Меню студента
+    void runProfessorMenu();    // Меню преподавателя
+
+public:
+    explicit SessionClient(const string& socketPath);
+    ~SessionClient();
+
+    SessionClient(const SessionClient&) = delete;
+    SessionClient& operator=(const SessionClient&) = delete;
+
+    bool isConnected() const { return fd >= 0; }
+    void run();                 // Главное меню до выхода или разрыва связи
+};
@@ -0,0 +1,208 @@
+#include "session_server.h"
+#include <iostream>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define HAS_EPOLL 1
+#endif
+
+using namespace std;
+
+namespace {
+
+volatile sig_atomic_t stopRequested = 0;
+
+void requestStop(int) {
+    stopRequested = 1;
+}
+
+const size_t MAX_REQUEST_BYTES = 64 * 1024;   // Длиннее строки запроса не бывает: соединение закрывается
+
+}
+
+SessionServer::SessionServer(UniversitySystem& system, const string& socketPath)
+    : system(system), socketPath(socketPath), listenFd(-1), epollFd(-1) {}
+
+SessionServer::~SessionServer() {
+#ifdef HAS_EPOLL
+    while (!connections.empty()) {
+        closeConnection(connections.begin()->first);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+#endif
+}
+
+#ifdef HAS_EPOLL
+
+bool SessionServer::run() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        cout << "Слишком длинный путь к сокету: " << socketPath << endl;
+        return false;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+    
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(socketPath.c_str());
+    if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenFd, SOMAXCONN) < 0) {
+        cout << "Не удалось открыть сокет " << socketPath << ": " << strerror(errno) << endl;
+        return false;
+    }
+    
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    
+    // Без SA_RESTART: сигнал прерывает epoll_wait, и цикл видит флаг остановки
+    struct sigaction action{};
+    action.sa_handler = requestStop;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+    
+    cout << "Сервер слушает " << socketPath << endl;
+    
+    epoll_event events[64];
+    while (!stopRequested) {
+        int ready = epoll_wait(epollFd, events, 64, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            cout << "Ошибка epoll_wait: " << strerror(errno) << endl;
+            break;
+        }
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            
+            bool alive = !(events[i].events & EPOLLERR);
+            if (alive && (events[i].events & (EPOLLIN | EPOLLHUP))) {
+                alive = readRequests(fd, it->second);
+            }
+            // Ответы на уже полученные запросы отправляются и перед закрытием
+            if (!it->second.output.empty()) {
+                alive = flushOutput(fd, it->second) && alive;
+            }
+            if (!alive) {
+                closeConnection(fd);
+            }
+        }
+    }
+    
+    cout << "Сервер останавливается, активных сессий: " << connections.size() << endl;
+    return true;
+}
+
+void SessionServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;   // EAGAIN - очередь подключений пуста
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        connections.emplace(fd, Connection());
+    }
+}
+
+bool SessionServer::readRequests(int fd, Connection& connection) {
+    char buffer[4096];
+    bool open = true;
+    while (open) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            connection.input.append(buffer, n);
+        } else if (n == 0) {
+            open = false;   // Клиент закрыл соединение, но его последние запросы выполняются
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            open = false;
+        }
+    }
+    
+    size_t start = 0;
+    size_t newline;
+    while ((newline = connection.input.find('\n', start)) != string::npos) {
+        string request = connection.input.substr(start, newline - start);
+        if (!request.empty() && request.back() == '\r') {
+            request.pop_back();
+        }
+        connection.output += system.handleRequest(connection.session, request);
+        start = newline + 1;
+    }
+    connection.input.erase(0, start);
+    return open && connection.input.size() <= MAX_REQUEST_BYTES;
+}
+
+bool SessionServer::flushOutput(int fd, Connection& connection) {
+    size_t sent = 0;
+    while (sent < connection.output.size()) {
+        ssize_t n = write(fd, connection.output.data() + sent, connection.output.size() - sent);
+        if (n > 0) {
+            sent += n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return false;
+    }
+    connection.output.erase(0, sent);
+    
+    // Ждать готовности к записи только пока в буфере что-то осталось
+    bool needWrite = !connection.output.empty();
+    if (needWrite != connection.writing) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        if (needWrite) {
+            event.events |= EPOLLOUT;
+        }
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        connection.writing = needWrite;
+    }
+    return true;
+}
+
+void SessionServer::closeConnection(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+}
+
+#else
+
+bool SessionServer::run() {
+    cout << "Режим сервера поддерживается только в Linux (epoll)\n";
+    return false;
+}
+
+void SessionServer::acceptConnections() {}
+bool SessionServer::readRequests(int, Connection&) { return false; }
+bool SessionServer::flushOutput(int, Connection&) { return false; }
+void SessionServer::closeConnection(int fd) { connections.erase(fd); }
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+#include "university_system.h"
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// СЕРВЕР СЕССИЙ (Unix-сокет, цикл epoll)
+// Один процесс держит данные в памяти и обслуживает много клиентов. Запрос - одна
+// строка, поля разделены табуляцией: КОМАНДА\tаргумент\t... Ответ - строка
+// "СТАТУС ДЛИНА" (OK, ERR или CONFIRM) и ДЛИНА байт текста для показа пользователю.
+// Все соединения обслуживает один поток: простаивающая сессия - это только
+// дескриптор в epoll и пара пустых буферов.
+class SessionServer {
+private:
+    struct Connection {
+        string input;            // Принятые байты, еще не разобранные на строки
+        string output;           // Ответы, еще не отправленные клиенту
+        bool writing = false;    // Подписаны на EPOLLOUT (output не уместился в сокет)
+        ClientSession session;   // Пользователь и списки этой сессии
+    };
+
+    UniversitySystem& system;
+    string socketPath;                          // Путь к сокету
+    int listenFd;                               // Слушающий сокет
+    int epollFd;                                // Дескриптор epoll
+    unordered_map<int, Connection> connections; // Соединения по дескриптору
+
+    void acceptConnections();                   // Принять все ожидающие подключения
+    bool readRequests(int fd, Connection& connection);   // Прочитать и выполнить запросы (false - закрыть)
+    bool flushOutput(int fd, Connection& connection);    // Отправить накопленные ответы (false - закрыть)
+    void closeConnection(int fd);
+
+public:
+    SessionServer(UniversitySystem& system, const string& socketPath);
+    ~SessionServer();
+
+    SessionServer(const SessionServer&) = delete;
+    SessionServer& operator=(const SessionServer&) = delete;
+
+    bool run();                 // Обслуживать клиентов до SIGINT/SIGTERM (false - не удалось запуститься)
+};
@@ -0,0 +1,61 @@
+#include "shard_executor.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+thread_local const void* currentShard = nullptr;   // Ящик, который разбирает этот поток
+}
+
+ShardedExecutor::ShardedExecutor(size_t workers) {
+    if (workers == 0) {
+        workers = max(1u, thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < workers; i++) {
+        shards.push_back(make_unique<Shard>());
+    }
+    for (auto& shard : shards) {
+        shard->worker = thread(&ShardedExecutor::run, this, ref(*shard));
+    }
+}
+
+ShardedExecutor::~ShardedExecutor() {
+    for (auto& shard : shards) {
+        lock_guard<mutex> lock(shard->mtx);
+        shard->stopping = true;
+        shard->wakeup.notify_one();
+    }
+    for (auto& shard : shards) {
+        shard->worker.join();
+    }
+}
+
+bool ShardedExecutor::isOwner(uint64_t key) const {
+    return currentShard == shards[shardOf(key)].get();
+}
+
+void ShardedExecutor::post(uint64_t key, function<void()> task) {
+    Shard& shard = *shards[shardOf(key)];
+    lock_guard<mutex> lock(shard.mtx);
+    shard.mailbox.push_back(move(task));
+    shard.wakeup.notify_one();
+}
+
+void ShardedExecutor::run(Shard& shard) {
+    currentShard = &shard;
+    unique_lock<mutex> lock(shard.mtx);
+    while (true) {
+        shard.wakeup.wait(lock, [&] { return shard.stopping || !shard.mailbox.empty(); });
+        if (shard.mailbox.empty()) {
+            break;
+        }
+        // Забираем весь ящик разом, чтобы отправители не ждали конца каждой операции
+        deque<function<void()>> batch;
+        batch.swap(shard.mailbox);
+        lock.unlock();
+        for (auto& task : batch) {
+            task();
+        }
+        lock.lock();
+    }
+}
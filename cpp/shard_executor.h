@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <cstdint>
+
+using namespace std;
+
+// ИСПОЛНИТЕЛЬ С ВЛАДЕЛЬЦАМИ КЛЮЧЕЙ (актор на группу предметов)
+// Каждый ключ закреплен за одним рабочим потоком (ключ по модулю числа потоков).
+// Операции над ключом попадают в почтовый ящик владельца и выполняются по одной
+// в порядке постановки: изменения одного ключа никогда не идут одновременно,
+// а ключи разных владельцев обрабатываются параллельно.
+class ShardedExecutor {
+private:
+    struct Shard {
+        mutex mtx;
+        condition_variable wakeup;         // Появилась операция или запрошена остановка
+        deque<function<void()>> mailbox;   // Операции в порядке постановки
+        bool stopping = false;             // Поток завершается после разбора ящика
+        thread worker;
+    };
+    vector<unique_ptr<Shard>> shards;
+
+    void run(Shard& shard);                            // Цикл рабочего потока
+    void post(uint64_t key, function<void()> task);    // Положить операцию в ящик владельца
+
+public:
+    explicit ShardedExecutor(size_t workers);          // 0 - по числу ядер
+    ~ShardedExecutor();                                // Выполнить поставленное и остановить потоки
+    ShardedExecutor(const ShardedExecutor&) = delete;
+    ShardedExecutor& operator=(const ShardedExecutor&) = delete;
+
+    size_t size() const { return shards.size(); }
+    size_t shardOf(uint64_t key) const { return key % shards.size(); }
+    bool isOwner(uint64_t key) const;                  // Текущий поток - владелец ключа
+
+    // Выполнить операцию в потоке-владельце ключа. Из самого владельца операция
+    // выполняется сразу: ожидание результата в своем же ящике было бы взаимоблокировкой
+    template <class F>
+    auto submit(uint64_t key, F&& task) -> future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = make_shared<packaged_task<Result()>>(forward<F>(task));
+        future<Result> result = packaged->get_future();
+        if (isOwner(key)) {
+            (*packaged)();
+        } else {
+            post(key, [packaged] { (*packaged)(); });
+        }
+        return result;
+    }
+};
@@ -1,6 +1,7 @@
 #include "student.h"
 #include "object.h"
 #include <iostream>
+#include <map>
 
 using namespace std;
 
@@ -19,15 +20,21 @@ void Student::save(ostream& file) const {
          << static_cast<int>(role) << "\n";
 }
 
-void Student::onGradeUpdated(const string& subjectName, 
-                            const string& assignment, 
-                            double grade) {
-    cout << "\n=== УВЕДОМЛЕНИЕ ОБ ОЦЕНКЕ ===\n";
-    cout << "Студент: " << name << "\n";
-    cout << "Предмет: " << subjectName << "\n";
-    cout << "Задание: " << assignment << "\n";
-    cout << "Оценка: " << grade << "\n";
-    cout << "================================\n\n";
+void Student::showGradeDigest(const vector<GradeNotification>& unread, ostream& out) const {
+    // Все оценки, пришедшие с прошлого входа, - одним уведомлением, по предметам
+    map<string, vector<const GradeNotification*>> bySubject;
+    for (const auto& notification : unread) {
+        bySubject[SymbolTable::name(notification.subjectId)].push_back(&notification);
+    }
+    out << "\n=== НОВЫЕ ОЦЕНКИ (" << unread.size() << ") ===\n";
+    out << "Студент: " << name << "\n";
+    for (const auto& [subjectName, notifications] : bySubject) {
+        out << "Предмет: " << subjectName << "\n";
+        for (const auto* notification : notifications) {
+            out << "  " << SymbolTable::name(notification->itemId) << ": " << notification->grade << "\n";
+        }
+    }
+    out << "================================\n\n";
 }
 
 shared_ptr<Student> Student::create(const string& name, 
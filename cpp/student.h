@@ -1,5 +1,6 @@
 #pragma once
 #include "user.h"
+#include "notification_queue.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -17,7 +18,7 @@ public:
     void displayInfo() const override;
     void save(ostream& file) const override;
     
-    void onGradeUpdated(const string& subjectName, const string& assignment, double grade);
+    void showGradeDigest(const vector<GradeNotification>& unread, ostream& out = cout) const;  // Сводка новых оценок при входе
     
     static shared_ptr<Student> create(const string& name, const string& password);
     static shared_ptr<Student> load(const string& name, const string& passwordHash, int id);
@@ -0,0 +1,43 @@
+#include "symbol_table.h"
+
+using namespace std;
+
+deque<string> SymbolTable::names;
+unordered_map<string_view, Symbol> SymbolTable::ids;
+RwLock SymbolTable::mtx;
+
+Symbol SymbolTable::intern(string_view name) {
+    // Почти все строки уже есть в таблице: сначала ищем под разделяемой блокировкой
+    Symbol known = find(name);
+    if (known != NONE) {
+        return known;
+    }
+
+    unique_lock<RwLock> lock(mtx);
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    Symbol symbol = names.size();
+    names.emplace_back(name);
+    ids.emplace(names.back(), symbol);
+    return symbol;
+}
+
+Symbol SymbolTable::find(string_view name) {
+    shared_lock<RwLock> lock(mtx);
+    auto it = ids.find(name);
+    return it != ids.end() ? it->second : NONE;
+}
+
+const string& SymbolTable::name(Symbol symbol) {
+    static const string unknown;
+    shared_lock<RwLock> lock(mtx);
+    return symbol < names.size() ? names[symbol] : unknown;
+}
+
+size_t SymbolTable::size() {
+    shared_lock<RwLock> lock(mtx);
+    return names.size();
+}
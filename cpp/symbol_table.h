@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include "rw_lock.h"
+#include <cstdint>
+
+using namespace std;
+
+using Symbol = uint32_t;   // Номер строки в таблице символов
+
+// ТАБЛИЦА СИМВОЛОВ (общая на весь процесс)
+// Названия предметов, заданий и докладов хранятся один раз, записи держат только
+// номер строки. Одинаковые строки получают одинаковый номер, поэтому сравнение
+// названий сводится к сравнению чисел. Номера не освобождаются до конца работы.
+// Поиск и чтение названий идут параллельно; монопольно берется только добавление новой строки.
+class SymbolTable {
+private:
+    static deque<string> names;                        // Строки по номеру (адреса не меняются при росте)
+    static unordered_map<string_view, Symbol> ids;     // Номер по строке (ключи указывают в names)
+    static RwLock mtx;
+
+public:
+    static constexpr Symbol NONE = UINT32_MAX;         // "Строка не встречалась"
+
+    static Symbol intern(string_view name);            // Номер строки, при необходимости добавить
+    static Symbol find(string_view name);              // Номер строки или NONE, таблица не растет
+    static const string& name(Symbol symbol);          // Строка по номеру
+    static size_t size();                              // Количество строк в таблице
+};
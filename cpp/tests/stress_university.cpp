@@ -0,0 +1,272 @@
+// НАГРУЗОЧНАЯ ПРОВЕРКА ПОТОКОБЕЗОПАСНОГО ИНТЕРФЕЙСА UniversitySystem
+// В чистом временном каталоге создает преподавателей, предметы и задания через протокол
+// сессий, зачисляет студентов импортом списка, затем параллельно сдает и оценивает задания
+// (по два писателя на предмет) под постоянным потоком чтений; параллельно студенты через
+// свои сессии записываются на доклады, половина затем отписывается. После нагрузки проверяет,
+// что каждая пара (студент, задание) оценена ровно один раз, очереди пусты, рейтинги полны,
+// ответ сессии содержит только ее вывод, на докладах остались записанные студенты
+// и система, загруженная заново с диска, видит то же самое. Сценарий проходит дважды:
+// с блокировками предметов и в режиме акторов (--subject-workers). Отдельно нагружает
+// SymbolTable одновременным добавлением и поиском строк.
+// Запуск: stress_university, код возврата 0 - инварианты выполнены
+#include "../university_system.h"
+#include "../data_manager.h"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <filesystem>
+
+using namespace std;
+
+namespace {
+
+const int SUBJECTS = 6;       // Предметов (и преподавателей)
+const int STUDENTS = 60;      // Студентов, каждый зачислен на все предметы
+const int ASSIGNMENTS = 8;    // Заданий в предмете
+const int READERS = 4;        // Потоков чтения
+
+// Вывод команд не нужен: он только замедляет прогон
+struct NullBuffer : streambuf {
+    int overflow(int c) override { return c; }
+};
+
+int failures = 0;
+
+void check(bool condition, const string& what) {
+    if (!condition) {
+        cerr << "НАРУШЕНО: " << what << "\n";
+        failures++;
+    }
+}
+
+string subjectName(int subject) { return "Subject" + to_string(subject); }
+string assignmentName(int assignment) { return "A" + to_string(assignment); }
+string reportName(int subject) { return "Talk" + to_string(subject); }
+
+// Запрос протокола от имени сессии, вернуть ответ целиком: "СТАТУС ДЛИНА\nтело"
+string requestReply(UniversitySystem& system, ClientSession& session, const vector<string>& fields) {
+    string line;
+    for (const auto& field : fields) {
+        line += (line.empty() ? "" : "\t") + field;
+    }
+    return system.handleRequest(session, line);
+}
+
+// То же, вернуть только статус ответа
+string request(UniversitySystem& system, ClientSession& session, const vector<string>& fields) {
+    string reply = requestReply(system, session, fields);
+    return reply.substr(0, reply.find(' '));
+}
+
+// Число докладов, доступных студенту для записи (по ответу AVAILABLE_REPORTS)
+size_t availableReports(UniversitySystem& system, int student) {
+    ClientSession session;
+    request(system, session, {"LOGIN", "student" + to_string(student), "secret"});
+    if (request(system, session, {"AVAILABLE_REPORTS"}) != "OK") {
+        return 0;
+    }
+    return session.listedReports.size();
+}
+
+// Одновременное добавление и поиск строк: номер строки один на всех, строка по номеру та же
+void stressSymbolTable() {
+    const int threads = 8;
+    const int names = 5000;
+    vector<vector<Symbol>> seen(threads, vector<Symbol>(names));
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < names; i++) {
+                // Потоки идут по строкам с разным сдвигом, чтобы добавления пересекались с поиском
+                int n = (i + t * names / threads) % names;
+                string name = "stress-symbol-" + to_string(n);
+                Symbol symbol = SymbolTable::intern(name);
+                seen[t][n] = symbol;
+                if (SymbolTable::name(symbol) != name || SymbolTable::find(name) != symbol) {
+                    seen[t][n] = SymbolTable::NONE;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    bool consistent = true;
+    for (int n = 0; n < names && consistent; n++) {
+        for (int t = 0; t < threads; t++) {
+            consistent = consistent && seen[t][n] != SymbolTable::NONE && seen[t][n] == seen[0][n];
+        }
+    }
+    check(consistent, "SymbolTable: одна строка получила разные номера или не нашлась");
+}
+
+// Полный сценарий в чистом каталоге; workers < 0 - без режима акторов
+void stressSystem(int workers) {
+    const string mode = workers < 0 ? "блокировки предметов: " : "режим акторов: ";
+    filesystem::path workDir = filesystem::temp_directory_path() / "lab5_stress_university";
+    filesystem::remove_all(workDir);
+    filesystem::create_directories(workDir / "data");
+    filesystem::current_path(workDir);
+
+    vector<int> studentIds;
+    vector<pair<int, double>> totalTop;
+    {
+        UniversitySystem system;
+        // Журнал пишется фоновым потоком, как на сервере с --group-commit
+        DataManager::startJournalWriter(2);
+        if (workers >= 0) {
+            system.startSubjectWorkers(workers);
+        }
+
+        for (int s = 0; s < SUBJECTS; s++) {
+            ClientSession professor;
+            string name = "professor" + to_string(s);
+            request(system, professor, {"REGISTER", name, "secret", "2"});
+            request(system, professor, {"LOGIN", name, "secret"});
+            check(request(system, professor, {"CREATE_SUBJECT", subjectName(s), "S" + to_string(s)}) == "OK",
+                  mode + "создание предмета " + subjectName(s));
+            for (int a = 0; a < ASSIGNMENTS; a++) {
+                request(system, professor, {"CREATE_ASSIGNMENT", subjectName(s), assignmentName(a), "100"});
+            }
+            request(system, professor, {"CREATE_REPORT", subjectName(s), reportName(s), to_string(STUDENTS)});
+        }
+
+        // Импорт выдает новым студентам сплошной блок ID начиная со следующего свободного
+        stringstream roster;
+        for (int i = 0; i < STUDENTS; i++) {
+            roster << "student" << i << ",secret";
+            for (int s = 0; s < SUBJECTS; s++) {
+                roster << "," << subjectName(s);
+            }
+            roster << "\n";
+        }
+        int firstId = User::getNextId();
+        ImportReport imported = system.importRoster(roster);
+        check(imported.applied == STUDENTS && imported.failures.empty(), mode + "импорт списка студентов");
+        for (int i = 0; i < STUDENTS; i++) {
+            studentIds.push_back(firstId + i);
+        }
+
+        atomic<bool> stop{false};
+        atomic<int> graded{0};
+        atomic<int> joined{0};
+        atomic<int> foreignOutput{0};
+        vector<thread> writers, readers;
+        // Студенты в своих сессиях записываются на все доклады, нечетные затем отписываются.
+        // Ответ на запись должен содержать только сообщение этой сессии
+        for (int w = 0; w < 2; w++) {
+            writers.emplace_back([&, w] {
+                for (int i = w; i < STUDENTS; i += 2) {
+                    ClientSession session;
+                    request(system, session, {"LOGIN", "student" + to_string(i), "secret"});
+                    request(system, session, {"AVAILABLE_REPORTS"});
+                    vector<shared_ptr<Report>> listed = session.listedReports;
+                    for (size_t n = 0; n < listed.size(); n++) {
+                        string reply = requestReply(system, session, {"JOIN_REPORT", to_string(n + 1)});
+                        string body = "Успешно записался на доклад: " + listed[n]->getTopic() + "\n";
+                        if (reply == "OK " + to_string(body.size()) + "\n" + body) {
+                            joined++;
+                        } else if (reply.rfind("OK ", 0) == 0) {
+                            foreignOutput++;
+                        }
+                        if (i % 2 == 1) {
+                            request(system, session, {"LEAVE_REPORT", listed[n]->getTopic()});
+                        }
+                    }
+                }
+            });
+        }
+        // Два писателя на предмет соревнуются за одни и те же пары (студент, задание)
+        for (int w = 0; w < 2 * SUBJECTS; w++) {
+            writers.emplace_back([&, w] {
+                const string subject = subjectName(w % SUBJECTS);
+                for (int a = 0; a < ASSIGNMENTS; a++) {
+                    for (int studentId : studentIds) {
+                        if ((studentId + a) % 3 == 0) {
+                            system.submitAssignment(studentId, subject, assignmentName(a));
+                        }
+                        if (system.gradeAssignment(studentId, subject, assignmentName(a),
+                                                   (studentId * 7 + a * 13) % 101)) {
+                            graded++;
+                        }
+                    }
+                }
+            });
+        }
+        for (int r = 0; r < READERS; r++) {
+            readers.emplace_back([&, r] {
+                ClientSession professor;
+                request(system, professor, {"LOGIN", "professor" + to_string(r % SUBJECTS), "secret"});
+                for (size_t i = 0; !stop; i++) {
+                    const string subject = subjectName((i + r) % SUBJECTS);
+                    system.listAllSubjects();
+                    system.showSubjectStatistics(subject);
+                    system.showStudentSubjectSummary(studentIds[i % STUDENTS]);
+                    system.showStudentRanking(subject, studentIds[i % STUDENTS]);
+                    system.getPendingSubmissions();
+                    system.getPendingSubmissions(subject);
+                    system.getTopStudents(5, subject);
+                    request(system, professor, {"GRADABLE_REPORTS"});
+                    request(system, professor, {"STATS", subjectName(r % SUBJECTS)});
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        check(graded == SUBJECTS * STUDENTS * ASSIGNMENTS, mode + "каждая пара оценена ровно один раз (" +
+              to_string(graded.load()) + " из " + to_string(SUBJECTS * STUDENTS * ASSIGNMENTS) + ")");
+        check(system.getPendingSubmissions().empty(), mode + "после оценки очередь проверки пуста");
+        for (int s = 0; s < SUBJECTS; s++) {
+            check(system.getTopStudents(STUDENTS * 2, subjectName(s)).size() == STUDENTS,
+                  mode + "рейтинг " + subjectName(s) + " содержит всех студентов");
+        }
+        check(joined == SUBJECTS * STUDENTS, mode + "каждый студент записан на каждый доклад (" +
+              to_string(joined.load()) + " из " + to_string(SUBJECTS * STUDENTS) + ")");
+        check(foreignOutput == 0, mode + "в ответ сессии попал чужой вывод");
+        for (int i = 0; i < STUDENTS; i++) {
+            // Оставшимся на докладах записываться некуда, отписавшимся доступны все доклады
+            check(availableReports(system, i) == (i % 2 == 0 ? 0u : size_t(SUBJECTS)),
+                  mode + "записи на доклады студента student" + to_string(i));
+        }
+        totalTop = system.getTopStudents(STUDENTS * 2);
+        check(totalTop.size() == STUDENTS, mode + "общий рейтинг содержит всех студентов");
+        check(!system.gradeAssignment(studentIds[0], subjectName(0), assignmentName(0), 50),
+              mode + "повторная оценка отклоняется");
+        system.stopSubjectWorkers();
+        DataManager::stopJournalWriter();
+    }
+
+    {
+        // Все оценки пережили сохранение: заново загруженная система видит тот же рейтинг
+        UniversitySystem reloaded;
+        check(reloaded.getTopStudents(STUDENTS * 2) == totalTop, mode + "рейтинг после перезагрузки совпадает");
+        check(availableReports(reloaded, 0) == 0 && availableReports(reloaded, 1) == SUBJECTS,
+              mode + "записи на доклады после перезагрузки совпадают");
+    }
+
+    filesystem::current_path(workDir.parent_path());
+    filesystem::remove_all(workDir);
+}
+
+}
+
+int main() {
+    NullBuffer nullBuffer;
+    streambuf* console = cout.rdbuf(&nullBuffer);
+
+    stressSymbolTable();
+    stressSystem(-1);
+    stressSystem(3);
+
+    cout.rdbuf(console);
+    cout << (failures == 0 ? "Инварианты выполнены\n" : "Нарушено инвариантов: " + to_string(failures) + "\n");
+    return failures == 0 ? 0 : 1;
+}
+//g++ -std=c++17 -O2 -pthread -o stress_university tests/stress_university.cpp data_manager.cpp gradebook.cpp journal_writer.cpp leaderboard.cpp mapped_file.cpp notification_queue.cpp object.cpp professor.cpp rw_lock.cpp score_kernels.cpp score_ranking.cpp shard_executor.cpp student.cpp symbol_table.cpp university_system.cpp user.cpp
@@ -1,4 +1,5 @@
 #include "university_system.h"
+#include "mapped_file.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -6,14 +7,24 @@
 #include <algorithm>
 #include <iomanip>
 #include <filesystem>
+#include <future>
+#include <tuple>
+#include <cmath>
 using namespace std;
 
+namespace {
+
+const size_t MAX_IMPORT_BYTES = 16 * 1024 * 1024;   // Больше строк импорта за один запрос сессия не принимает
+
+}
+
 UniversitySystem::UniversitySystem() {
     DataManager::initDataDirectory();
     loadAllData();
 }
 
 UniversitySystem::~UniversitySystem() {
+    stopSubjectWorkers();
     saveAllData();
 }
 
@@ -34,92 +45,106 @@ void UniversitySystem::run() {
     }
 }
 
+string UniversitySystem::handleRequest(ClientSession& session, const string& request) {
+    vector<string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = request.find('\t', start);
+        fields.push_back(request.substr(start, tab - start));
+        if (tab == string::npos) break;
+        start = tab + 1;
+    }
+    
+    // Вывод команды собирается в тело ответа; глобальные cout и currentUser не трогаются,
+    // поэтому запросы разных сессий могут выполняться параллельно
+    ostringstream output;
+    string status;
+    try {
+        status = executeRequest(session, fields, output);
+    } catch (const exception&) {
+        output << "Неверный формат запроса\n";
+        status = "ERR";
+    }
+    
+    string body = output.str();
+    return status + " " + to_string(body.size()) + "\n" + body;
+}
+
 // ==================== ПРИВАТНЫЕ МЕТОДЫ ====================
 
 void UniversitySystem::loadAllData() {
+    DataManager::recoverCheckpoint();
     int nextId = DataManager::loadNextUserId();
     User::updateNextId(nextId);
     
-    users = DataManager::loadUsers();
-    subjects = DataManager::loadSubjects();
+    // Файлы независимы: читаем и разбираем их параллельно,
+    // связывание ниже ждет только тех результатов, которые ему нужны
+    auto usersTask = async(launch::async, DataManager::loadUsers);
+    auto subjectsTask = async(launch::async, DataManager::loadSubjects);
+    auto subjectGradesTask = async(launch::async, DataManager::loadSubjectGrades);
+    auto assignmentsTask = async(launch::async, DataManager::loadAssignments);
+    auto reportsTask = async(launch::async, DataManager::loadReports);
+    auto enrollmentsTask = async(launch::async, DataManager::loadEnrollments);
+    // Сдачи и оценки: бинарный снимок, если он есть, иначе текстовые файлы
+    bool loadedFromSnapshot = false;
+    auto historyTask = async(launch::async, [&loadedFromSnapshot] {
+        pair<vector<DataSubmission>, vector<DataGrade>> history;
+        loadedFromSnapshot = DataManager::loadSnapshot(history.first, history.second);
+        if (!loadedFromSnapshot) {
+            auto gradesTask = async(launch::async, DataManager::loadGrades);
+            history.first = DataManager::loadSubmissions();
+            history.second = gradesTask.get();
+        }
+        return history;
+    });
     
-    auto subjectGradesMap = DataManager::loadSubjectGrades();
+    subjects = subjectsTask.get();
+    rebuildSubjectIndexes();
     
-    auto loadedAssignments = DataManager::loadAssignments();
+    auto loadedAssignments = assignmentsTask.get();
     assignments.clear();
     
-    for (const auto& assignmentPtr : loadedAssignments) {
-        string subjectName = assignmentPtr->getSubjectName();
-        double maxScore = assignmentPtr->getMaxScore();
-        
-        if (subjectName.empty()) {
+    for (const auto& assignment : loadedAssignments) {
+        if (assignment->getSubjectName().empty()) {
             continue;
         }
         
-        bool subjectFound = false;
-        for (const auto& sysSubject : subjects) {
-            if (sysSubject->getName() == subjectName) {
-                auto assignment = make_shared<Assignment>(
-                    assignmentPtr->getName(),
-                    subjectName,
-                    maxScore
-                );
-                assignments.push_back(assignment);
-                sysSubject->addAssignment(assignment->getName());
-                subjectFound = true;
-                break;
-            }
-        }
-        
-        if (!subjectFound) {
-            assignments.push_back(assignmentPtr);
+        assignments.push_back(assignment);
+        auto subject = findSubject(assignment->getSubjectName());
+        if (subject) {
+            subject->addAssignment(SymbolTable::intern(assignment->getName()), assignment->getMaxScore());
         }
     }
     
-    auto loadedReports = DataManager::loadReports();
+    auto loadedReports = reportsTask.get();
     reports.clear();
     
-    for (const auto& reportPtr : loadedReports) {
-        string subjectName = reportPtr->getSubjectName();
-        bool subjectFound = false;
-        for (const auto& sysSubject : subjects) {
-            if (sysSubject->getName() == subjectName) {
-                auto report = make_shared<Report>(
-                    reportPtr->getTopic(),
-                    subjectName,
-                    reportPtr->getMaxParticipants()
-                );
-                
-                auto studentIds = reportPtr->getSignedUpStudents();
-                for (int studentId : studentIds) {
-                    report->addStudent(studentId);
-                }
-                
-                if (reportPtr->getIsCompleted()) {
-                    report->markAsCompleted();
-                }
-                
-                reports.push_back(report);
-                sysSubject->addReport(reportPtr->getTopic());
-                subjectFound = true;
-                break;
-            }
+    for (const auto& report : loadedReports) {
+        auto subject = findSubject(report->getSubjectName());
+        if (subject) {
+            reports.push_back(report);
+            subject->addReport(SymbolTable::intern(report->getTopic()));
         }
     }
     
-    studentEnrollments = DataManager::loadEnrollments();
+    studentEnrollments.clear();
+    subjectEnrollments.clear();
     
-    for (const auto& [studentId, subjectNames] : studentEnrollments) {
+    for (const auto& [studentId, subjectNames] : enrollmentsTask.get()) {
+        auto& studentSubjects = studentEnrollments[studentId];
         for (const auto& subjectName : subjectNames) {
+            Symbol subjectId = SymbolTable::intern(subjectName);
+            studentSubjects.insert(subjectId);
             auto subject = findSubject(subjectName);
             if (subject) {
                 subject->enrollStudent(studentId);
-                subjectEnrollments[subjectName].push_back(studentId);
+                subjectEnrollments[subjectId].insert(studentId);
             }
         }
     }
     
     // ЗАГРУЗКА ОЦЕНОК ИЗ subject_grades.txt
+    auto subjectGradesMap = subjectGradesTask.get();
     for (const auto& [subjectName, subjectGrades] : subjectGradesMap) {
         auto subject = findSubject(subjectName);
         
@@ -128,9 +153,10 @@ void UniversitySystem::loadAllData() {
             for (const auto& [assignmentName, grade] : grades) {
                 if (!subject->isStudentEnrolled(studentId)) {
                     subject->enrollStudent(studentId);
-                    studentEnrollments[studentId].push_back(subjectName);
+                    recordEnrollment(studentId, subjectName);
+                    markDirty(DATA_ENROLLMENTS);
                 }
-                subject->gradeAssignment(studentId, assignmentName, grade);
+                subject->gradeAssignment(studentId, SymbolTable::intern(assignmentName), grade);
             }
         }
         
@@ -139,45 +165,62 @@ void UniversitySystem::loadAllData() {
             for (const auto& [reportName, grade] : grades) {
                 if (!subject->isStudentEnrolled(studentId)) {
                     subject->enrollStudent(studentId);
-                    studentEnrollments[studentId].push_back(subjectName);
+                    recordEnrollment(studentId, subjectName);
+                    markDirty(DATA_ENROLLMENTS);
                 }
-                subject->gradeReport(studentId, reportName, grade);
+                subject->gradeReport(studentId, SymbolTable::intern(reportName), grade);
             }
         }
     }
     
-    auto submissionsData = DataManager::loadSubmissions();
+    auto [submissionsData, gradesData] = historyTask.get();
+    // Формат хранения сменился: при следующем сохранении переписать сдачи и оценки целиком
+    if (loadedFromSnapshot != DataManager::isBinarySnapshot()) {
+        markDirty(DATA_SUBMISSIONS | DATA_GRADES);
+    }
+    
     submissions.clear();
     for (const auto& sub : submissionsData) {
         SubmissionRecord rec;
         rec.studentId = sub.studentId;
-        rec.subjectName = sub.subjectName;
-        rec.assignmentName = sub.assignmentName;
-        rec.type = "assignment";
-        for (const auto& report : reports) {
-            if (report->getTopic() == sub.assignmentName) {
-                rec.type = "report";
-                break;
-            }
+        rec.subjectId = SymbolTable::intern(sub.subjectName);
+        rec.itemId = SymbolTable::intern(sub.assignmentName);
+        rec.type = sub.type;
+        if (rec.type.empty()) {
+            // Старый формат без типа: доклад, если у предмета есть доклад с такой темой
+            auto subject = findSubject(sub.subjectName);
+            bool isReport = subject && (subject->hasReport(rec.itemId) || subject->isReportGraded(rec.itemId));
+            rec.type = isReport ? "report" : "assignment";
+            markDirty(DATA_SUBMISSIONS);
         }
         rec.status = sub.status;
         rec.timestamp = sub.timestamp;
         submissions.push_back(rec);
     }
+    rebuildSubmissionIndex();
+    rebuildPendingQueues();
     
-    auto gradesData = DataManager::loadGrades();
     grades.clear();
     for (const auto& g : gradesData) {
         GradeRecord rec;
         rec.studentId = g.studentId;
-        rec.subjectName = g.subjectName;
-        rec.itemName = g.assignmentName;
+        rec.subjectId = SymbolTable::intern(g.subjectName);
+        rec.itemId = SymbolTable::intern(g.assignmentName);
         rec.type = g.type;
         rec.score = g.score;
         rec.timestamp = g.timestamp;
         grades.push_back(rec);
+        
+        if (rec.type == "report") {
+            auto subject = findSubject(g.subjectName);
+            if (subject) {
+                subject->markReportGraded(rec.itemId);
+            }
+        }
     }
+    rebuildSubjectStatistics();
     
+    users = usersTask.get();
     for (const auto& [name, user] : users) {
         if (user->getRole() == User::Role::STUDENT) {
             auto student = dynamic_pointer_cast<Student>(user);
@@ -191,66 +234,290 @@ void UniversitySystem::loadAllData() {
             }
         }
     }
+    
+    // Повтор изменений, записанных в журнал после последней контрольной точки
+    for (const auto& record : DataManager::loadJournal()) {
+        if (!applyJournalRecord(record)) {
+            DataManager::reportMalformedLine("journal.log", record.lineNumber);
+        }
+    }
+    rebuildLeaderboards();
+}
+
+bool UniversitySystem::saveAllData() {
+    unique_lock<RwLock> state(stateMutex);
+    return saveAllDataLocked();
 }
 
-void UniversitySystem::saveAllData() {
+bool UniversitySystem::saveAllDataLocked() {
+    // snapshot.bin хранит и сдачи, и оценки, поэтому в этом режиме они сохраняются вместе
+    unsigned collections = dirtyCollections;
+    if (DataManager::isBinarySnapshot() && (collections & (DATA_SUBMISSIONS | DATA_GRADES))) {
+        collections |= DATA_SUBMISSIONS | DATA_GRADES;
+    }
+    
     vector<DataSubmission> submissionsData;
-    for (const auto& sub : submissions) {
-        DataSubmission s;
-        s.studentId = sub.studentId;
-        s.subjectName = sub.subjectName;
-        s.assignmentName = sub.assignmentName;
-        s.status = sub.status;
-        s.timestamp = sub.timestamp;
-        submissionsData.push_back(s);
+    if (collections & DATA_SUBMISSIONS) {
+        for (const auto& sub : submissions) {
+            DataSubmission s;
+            s.studentId = sub.studentId;
+            s.subjectName = SymbolTable::name(sub.subjectId);
+            s.assignmentName = SymbolTable::name(sub.itemId);
+            s.status = sub.status;
+            s.timestamp = sub.timestamp;
+            s.type = sub.type;
+            submissionsData.push_back(s);
+        }
     }
     
     vector<DataGrade> gradesData;
-    for (const auto& g : grades) {
-        DataGrade grade;
-        grade.studentId = g.studentId;
-        grade.subjectName = g.subjectName;
-        grade.assignmentName = g.itemName;
-        grade.type = g.type;
-        grade.score = g.score;
-        grade.timestamp = g.timestamp;
-        gradesData.push_back(grade);
+    if (collections & DATA_GRADES) {
+        for (const auto& g : grades) {
+            DataGrade grade;
+            grade.studentId = g.studentId;
+            grade.subjectName = SymbolTable::name(g.subjectId);
+            grade.assignmentName = SymbolTable::name(g.itemId);
+            grade.type = g.type;
+            grade.score = g.score;
+            grade.timestamp = g.timestamp;
+            gradesData.push_back(grade);
+        }
+    }
+    
+    map<int, set<string>> enrollmentsData;
+    if (collections & DATA_ENROLLMENTS) {
+        for (const auto& [studentId, subjectIds] : studentEnrollments) {
+            auto& names = enrollmentsData[studentId];
+            for (Symbol subjectId : subjectIds) {
+                names.insert(SymbolTable::name(subjectId));
+            }
+        }
     }
     
-    DataManager::saveAllData(users, subjects, assignments, reports,
-                            studentEnrollments, submissionsData, gradesData);
+    // При ошибке записи коллекции остаются отмеченными и сохранятся следующей попыткой
+    if (!DataManager::saveAllData(users, subjects, assignments, reports,
+                                  enrollmentsData, submissionsData, gradesData, collections)) {
+        return false;
+    }
+    dirtyCollections = 0;
+    return true;
+}
+
+void UniversitySystem::logChange(const string& type, const vector<string>& fields) {
+    markDirty(collectionsForChange(type));
+    if (DataManager::isJournalMode()) {
+        DataManager::appendJournal(type, fields);
+    }
+}
+
+void UniversitySystem::commitChanges() {
+    // Вызывается без удерживаемых блокировок: контрольная точка берет stateMutex монопольно
+    {
+        shared_lock<RwLock> state(stateMutex);
+        shared_lock<RwLock> records(recordsMutex);
+        if (DataManager::isJournalMode() && !DataManager::needsCheckpoint()) {
+            return;
+        }
+    }
+    saveAllData();
+}
+
+unsigned UniversitySystem::collectionsForChange(const string& type) {
+    if (type == "USER") return DATA_USERS | DATA_NEXT_ID;
+    if (type == "SUBJECT") return DATA_SUBJECTS;
+    if (type == "ASSIGNMENT") return DATA_ASSIGNMENTS;
+    if (type == "REPORT" || type == "REPORT_JOIN" || 
+        type == "REPORT_LEAVE" || type == "REPORT_REMOVE") return DATA_REPORTS;
+    if (type == "ENROLL") return DATA_ENROLLMENTS;
+    if (type == "SUBMISSION") return DATA_SUBMISSIONS;
+    if (type == "GRADE") return DATA_GRADES | DATA_SUBJECT_GRADES;
+    return DATA_ALL;
 }
 
-bool UniversitySystem::login(const string& name, const string& password) {
-    auto it = users.find(name);
-    if (it == users.end()) {
-        cout << "Пользователь не найден!\n";
+bool UniversitySystem::applyJournalRecord(const JournalRecord& record) {
+    // Поля разбираются до изменения данных: поврежденная запись не применяется частично
+    const auto& f = record.fields;
+    if (record.type == "USER" && f.size() >= 4) {
+        // id, имя, хэш пароля, роль
+        int id, roleValue;
+        if (!parseInt(f[0], id) || !parseInt(f[3], roleValue)) {
+            return false;
+        }
+        shared_ptr<User> user;
+        switch (static_cast<User::Role>(roleValue)) {
+            case User::Role::STUDENT:
+                user = Student::load(f[1], f[2], id);
+                break;
+            case User::Role::PROFESSOR:
+                user = Professor::load(f[1], f[2], id);
+                break;
+        }
+        if (!user) {
+            return false;
+        }
+        if (users.find(f[1]) == users.end()) {
+            users[f[1]] = user;
+            if (auto student = dynamic_pointer_cast<Student>(user)) {
+                students[id] = student;
+            } else {
+                professors[id] = dynamic_pointer_cast<Professor>(user);
+            }
+        }
+    } else if (record.type == "SUBJECT" && f.size() >= 3) {
+        // название, код, ID преподавателя
+        int professorId;
+        if (!parseInt(f[2], professorId)) {
+            return false;
+        }
+        if (findSubject(f[0])) {
+            replaceSubjectProfessor(f[0], f[1], professorId);
+        } else {
+            auto subject = make_shared<Subject>(f[0], f[1], professorId);
+            subjects.push_back(subject);
+            indexSubject(subject);
+        }
+    } else if (record.type == "ASSIGNMENT" && f.size() >= 3) {
+        // название, максимальный балл, предмет
+        double maxScore;
+        if (!parseDouble(f[1], maxScore)) {
+            return false;
+        }
+        assignments.push_back(make_shared<Assignment>(f[0], f[2], maxScore));
+        auto subject = findSubject(f[2]);
+        if (subject) {
+            subject->addAssignment(SymbolTable::intern(f[0]), maxScore);
+        }
+    } else if (record.type == "REPORT" && f.size() >= 3) {
+        // тема, предмет, макс. участников
+        int maxParticipants;
+        if (!parseInt(f[2], maxParticipants)) {
+            return false;
+        }
+        reports.push_back(make_shared<Report>(f[0], f[1], maxParticipants));
+        auto subject = findSubject(f[1]);
+        if (subject) {
+            subject->addReport(SymbolTable::intern(f[0]));
+        }
+    } else if ((record.type == "REPORT_JOIN" || record.type == "REPORT_LEAVE") && f.size() >= 3) {
+        // предмет, тема, ID студента
+        int studentId;
+        if (!parseInt(f[2], studentId)) {
+            return false;
+        }
+        auto report = findReportForSubject(f[0], f[1]);
+        if (report) {
+            if (record.type == "REPORT_JOIN") {
+                report->addStudent(studentId);
+            } else {
+                report->removeStudent(studentId);
+            }
+        }
+    } else if (record.type == "REPORT_REMOVE" && f.size() >= 2) {
+        // предмет, тема
+        removeReport(f[0], f[1]);
+    } else if (record.type == "ENROLL" && f.size() >= 2) {
+        // ID студента, предмет
+        int studentId;
+        if (!parseInt(f[0], studentId)) {
+            return false;
+        }
+        auto subject = findSubject(f[1]);
+        if (subject && recordEnrollment(studentId, f[1])) {
+            subject->enrollStudent(studentId);
+        }
+    } else if (record.type == "SUBMISSION" && f.size() >= 6) {
+        // ID студента, предмет, задание, тип, статус, время
+        SubmissionRecord rec;
+        if (!parseInt(f[0], rec.studentId)) {
+            return false;
+        }
+        rec.subjectId = SymbolTable::intern(f[1]);
+        rec.itemId = SymbolTable::intern(f[2]);
+        rec.type = f[3];
+        rec.status = f[4];
+        rec.timestamp = DataManager::parseTimestamp(f[5]);
+        
+        auto existing = findSubmission(rec.studentId, rec.subjectId, rec.itemId, rec.type);
+        if (existing) {
+            setSubmissionStatus(existing, rec.status, rec.timestamp);
+        } else {
+            addSubmission(rec);
+        }
+    } else if (record.type == "GRADE" && f.size() >= 6) {
+        // ID студента, предмет, задание/доклад, тип, оценка, время
+        GradeRecord rec;
+        if (!parseInt(f[0], rec.studentId) || !parseDouble(f[4], rec.score)) {
+            return false;
+        }
+        rec.subjectId = SymbolTable::intern(f[1]);
+        rec.itemId = SymbolTable::intern(f[2]);
+        rec.type = f[3];
+        rec.timestamp = DataManager::parseTimestamp(f[5]);
+        addGrade(rec);
+        
+        auto subject = findSubject(f[1]);
+        if (subject) {
+            if (rec.type == "report") {
+                subject->markReportGraded(rec.itemId);
+                subject->gradeReport(rec.studentId, rec.itemId, rec.score);
+            } else {
+                subject->gradeAssignment(rec.studentId, rec.itemId, rec.score);
+            }
+        }
+    } else {
+        // Неизвестный тип или не хватает полей
+        return false;
+    }
+    // Повторенная запись еще не попала в файлы контрольной точки
+    markDirty(collectionsForChange(record.type));
+    return true;
+}
+
+bool UniversitySystem::login(const string& name, const string& password,
+                             shared_ptr<User>& sessionUser, ostream& out) {
+    shared_ptr<User> user;
+    {
+        shared_lock<RwLock> state(stateMutex);
+        auto it = users.find(name);
+        if (it != users.end()) {
+            user = it->second;
+        }
+    }
+    if (!user) {
+        out << "Пользователь не найден!\n";
         return false;
     }
     
-    if (it->second->checkPassword(password)) {
-        currentUser = it->second;
-        cout << "\n=== Вход успешен! ===\n";
-        cout << "Добро пожаловать, " << name << " (" 
-                  << it->second->getRoleString() << ")\n";
+    if (user->checkPassword(password)) {
+        sessionUser = user;
+        out << "\n=== Вход успешен! ===\n";
+        out << "Добро пожаловать, " << name << " (" 
+                  << user->getRoleString() << ")\n";
+        if (auto student = dynamic_pointer_cast<Student>(user)) {
+            auto unread = notifications.takeUnread(student->getId());
+            if (!unread.empty()) {
+                student->showGradeDigest(unread, out);
+            }
+        }
         return true;
     }
     
-    cout << "Неверный пароль!\n";
+    out << "Неверный пароль!\n";
     return false;
 }
 
-void UniversitySystem::logout() {
-    if (currentUser) {
-        cout << "Выход из системы пользователя: " << currentUser->getName() << endl;
-        currentUser = nullptr;
+void UniversitySystem::logout(shared_ptr<User>& sessionUser, ostream& out) {
+    if (sessionUser) {
+        out << "Выход из системы пользователя: " << sessionUser->getName() << endl;
+        sessionUser = nullptr;
     }
 }
 
 bool UniversitySystem::registerUser(const string& name, const string& password,
-                                   User::Role role) {
+                                   User::Role role, ostream& out) {
+    unique_lock<RwLock> state(stateMutex);
     if (users.find(name) != users.end()) {
-        cout << "Пользователь с таким именем уже существует!\n";
+        out << "Пользователь с таким именем уже существует!\n";
         return false;
     }
     
@@ -267,8 +534,11 @@ bool UniversitySystem::registerUser(const string& name, const string& password,
     }
     
     users[name] = user;
-    cout << "Пользователь " << name << " успешно зарегистрирован!\n";
-    saveAllData();
+    out << "Пользователь " << name << " успешно зарегистрирован!\n";
+    logChange("USER", {to_string(user->getId()), name, user->getPasswordHash(),
+                       to_string(static_cast<int>(role))});
+    state.unlock();
+    commitChanges();
     return true;
 }
 
@@ -290,7 +560,7 @@ void UniversitySystem::showMainMenu() {
             getline(cin, name);
             cout << "Пароль: ";
             getline(cin, password);
-            login(name, password);
+            login(name, password, currentUser);
             break;
         }
         case 2: {
@@ -331,20 +601,25 @@ void UniversitySystem::showMainMenu() {
 
 bool UniversitySystem::isStudentAlreadyEnrolled(int studentId, const string& subjectName) const {
     auto it = studentEnrollments.find(studentId);
-    if (it != studentEnrollments.end()) {
-        const auto& subjects = it->second;
-        return find(subjects.begin(), subjects.end(), subjectName) != subjects.end();
+    Symbol subjectId = SymbolTable::find(subjectName);
+    return it != studentEnrollments.end() && subjectId != SymbolTable::NONE &&
+           it->second.count(subjectId) > 0;
+}
+
+bool UniversitySystem::recordEnrollment(int studentId, const string& subjectName) {
+    Symbol subjectId = SymbolTable::intern(subjectName);
+    if (!studentEnrollments[studentId].insert(subjectId).second) {
+        return false;
     }
-    return false;
+    subjectEnrollments[subjectId].insert(studentId);
+    return true;
 }
 
 shared_ptr<Subject> UniversitySystem::findSubjectByNameOrCode(const string& identifier) const {
     if (!identifier.empty() && identifier[0] == '$') {
-        string code = identifier.substr(1);
-        for (const auto& subject : subjects) {
-            if (subject->getCode() == code) {
-                return subject;
-            }
+        auto it = subjectsByCode.find(identifier.substr(1));
+        if (it != subjectsByCode.end()) {
+            return it->second;
         }
     }
     return findSubject(identifier);
@@ -359,7 +634,7 @@ void UniversitySystem::removeReport(const string& subjectName, const string& rep
     
     auto subject = findSubject(subjectName);
     if (subject) {
-        subject->removeReport(reportName);
+        subject->removeReport(SymbolTable::find(reportName));
     }
 }
 
@@ -375,14 +650,38 @@ shared_ptr<Report> UniversitySystem::findReportForSubject(const string& subjectN
 }
 
 shared_ptr<Subject> UniversitySystem::findSubject(const string& name) const {
-    for (const auto& subject : subjects) {
-        if (subject->getName() == name) {
-            return subject;
-        }
+    return findSubject(SymbolTable::find(name));
+}
+
+shared_ptr<Subject> UniversitySystem::findSubject(Symbol subjectId) const {
+    auto it = subjectsByName.find(subjectId);
+    if (it != subjectsByName.end()) {
+        return it->second;
     }
     return nullptr;
 }
 
+Symbol UniversitySystem::subjectKey(const string& identifier) const {
+    // Неизвестный предмет уходит владельцу NONE: операция сама сообщит об ошибке
+    shared_lock<RwLock> state(stateMutex);
+    auto subject = findSubjectByNameOrCode(identifier);
+    return SymbolTable::find(subject ? subject->getName() : identifier);
+}
+
+void UniversitySystem::indexSubject(const shared_ptr<Subject>& subject) {
+    // emplace не перезаписывает: при совпадении побеждает предмет, добавленный раньше
+    subjectsByName.emplace(subject->getId(), subject);
+    subjectsByCode.emplace(subject->getCode(), subject);
+}
+
+void UniversitySystem::rebuildSubjectIndexes() {
+    subjectsByName.clear();
+    subjectsByCode.clear();
+    for (const auto& subject : subjects) {
+        indexSubject(subject);
+    }
+}
+
 shared_ptr<Report> UniversitySystem::findReport(const string& topic) const {
     for (const auto& report : reports) {
         if (report->getTopic() == topic) {
@@ -392,6 +691,130 @@ shared_ptr<Report> UniversitySystem::findReport(const string& topic) const {
     return nullptr;
 }
 
+size_t SubmissionKeyHash::operator()(const SubmissionKey& key) const {
+    size_t h = hash<int>()(key.studentId);
+    h = h * 31 + key.subjectId;
+    h = h * 31 + key.itemId;
+    h = h * 31 + hash<string>()(key.type);
+    return h;
+}
+
+void UniversitySystem::addSubmission(const SubmissionRecord& submission) {
+    submissions.push_back(submission);
+    submissionIndex[SubmissionKey{submission.studentId, submission.subjectId,
+                                  submission.itemId, submission.type}].push_back(submissions.size() - 1);
+    if (submission.type == "assignment") {
+        subjectStats[submission.subjectId].submitted++;
+    }
+    if (submission.status == "pending") {
+        enqueuePending(submissions.size() - 1);
+    }
+}
+
+void UniversitySystem::setSubmissionStatus(SubmissionRecord* submission, const string& status,
+                                           long long timestamp) {
+    size_t position = submission - submissions.data();
+    if (submission->status == "pending") {
+        dequeuePending(position);
+    }
+    submission->status = status;
+    submission->timestamp = timestamp;
+    if (status == "pending") {
+        enqueuePending(position);
+    }
+}
+
+void UniversitySystem::enqueuePending(size_t position) {
+    const auto& sub = submissions[position];
+    pendingBySubject[sub.subjectId].insert({sub.timestamp, position});
+    subjectStats[sub.subjectId].pending++;
+    auto subject = findSubject(sub.subjectId);
+    if (subject) {
+        pendingByProfessor[subject->getProfessorId()].insert({sub.timestamp, position});
+    }
+}
+
+void UniversitySystem::dequeuePending(size_t position) {
+    const auto& sub = submissions[position];
+    if (pendingBySubject[sub.subjectId].erase({sub.timestamp, position})) {
+        subjectStats[sub.subjectId].pending--;
+    }
+    auto subject = findSubject(sub.subjectId);
+    if (subject) {
+        pendingByProfessor[subject->getProfessorId()].erase({sub.timestamp, position});
+    }
+}
+
+void UniversitySystem::rebuildPendingQueues() {
+    pendingBySubject.clear();
+    pendingByProfessor.clear();
+    for (auto& [subjectId, stats] : subjectStats) {
+        stats.pending = 0;
+    }
+    for (size_t i = 0; i < submissions.size(); i++) {
+        if (submissions[i].status == "pending") {
+            enqueuePending(i);
+        }
+    }
+}
+
+void SubjectStats::addScore(double score) {
+    if (gradeCount == 0 || score < min) {
+        min = score;
+    }
+    if (gradeCount == 0 || score > max) {
+        max = score;
+    }
+    gradeCount++;
+    sum += score;
+    sumSquares += score * score;
+}
+
+void UniversitySystem::addGrade(const GradeRecord& grade) {
+    grades.push_back(grade);
+    subjectStats[grade.subjectId].addScore(grade.score);
+}
+
+void UniversitySystem::rebuildSubjectStatistics() {
+    // Счетчик работ на проверке ведут очереди (enqueuePending/dequeuePending)
+    for (auto& [subjectId, stats] : subjectStats) {
+        int pending = stats.pending;
+        stats = SubjectStats();
+        stats.pending = pending;
+    }
+    for (const auto& sub : submissions) {
+        if (sub.type == "assignment") {
+            subjectStats[sub.subjectId].submitted++;
+        }
+    }
+    for (const auto& grade : grades) {
+        subjectStats[grade.subjectId].addScore(grade.score);
+    }
+}
+
+void UniversitySystem::rebuildSubmissionIndex() {
+    submissionIndex.clear();
+    for (size_t i = 0; i < submissions.size(); i++) {
+        const auto& sub = submissions[i];
+        submissionIndex[SubmissionKey{sub.studentId, sub.subjectId, sub.itemId, sub.type}].push_back(i);
+    }
+}
+
+SubmissionRecord* UniversitySystem::findSubmission(int studentId, Symbol subjectId, Symbol itemId,
+                                                   const string& type, const string& status) {
+    auto it = submissionIndex.find(SubmissionKey{studentId, subjectId, itemId, type});
+    if (it == submissionIndex.end()) {
+        return nullptr;
+    }
+    // Статус не входит в ключ: его смена не требует обновления индекса
+    for (size_t position : it->second) {
+        if (status.empty() || submissions[position].status == status) {
+            return &submissions[position];
+        }
+    }
+    return nullptr;
+}
+
 shared_ptr<Student> UniversitySystem::findStudentById(int id) const {
     auto it = students.find(id);
     if (it != students.end()) {
@@ -401,442 +824,1564 @@ shared_ptr<Student> UniversitySystem::findStudentById(int id) const {
 }
 
 void UniversitySystem::addSubject(shared_ptr<Subject> subject) {
-    subjects.push_back(subject);
-    saveAllData();
+    {
+        unique_lock<RwLock> state(stateMutex);
+        subjects.push_back(subject);
+        indexSubject(subject);
+        logChange("SUBJECT", {subject->getName(), subject->getCode(),
+                              to_string(subject->getProfessorId())});
+    }
+    commitChanges();
 }
 
-void UniversitySystem::enrollStudentInSubject(int studentId, const string& identifier) {
+void UniversitySystem::replaceSubjectProfessor(const string& name, const string& code, int professorId) {
+    auto existingSubject = findSubject(name);
+    if (!existingSubject) {
+        return;
+    }
+    
+    auto newSubject = make_shared<Subject>(name, code, professorId);
+    
+    for (int studentId : existingSubject->getEnrolledStudentIds()) {
+        newSubject->enrollStudent(studentId);
+    }
+    for (Symbol assignmentId : existingSubject->getAssignmentList()) {
+        newSubject->addAssignment(assignmentId, existingSubject->getAssignmentMaxScore(assignmentId));
+    }
+    for (Symbol reportId : existingSubject->getReportList()) {
+        newSubject->addReport(reportId);
+    }
+    
+    newSubject->setAssignmentGrades(existingSubject->getAllAssignmentGrades());
+    newSubject->setReportGrades(existingSubject->getAllReportGrades());
+    for (const auto& g : grades) {
+        if (g.type == "report" && g.subjectId == newSubject->getId()) {
+            newSubject->markReportGraded(g.itemId);
+        }
+    }
+    
+    for (auto& subject : subjects) {
+        if (subject->getName() == name) {
+            subject = newSubject;
+            break;
+        }
+    }
+    // Код предмета и преподаватель изменились - пересобираем индексы и очереди
+    rebuildSubjectIndexes();
+    rebuildPendingQueues();
+    
+    for (auto& report : reports) {
+        if (report->getSubjectName() == name) {
+            auto newReport = make_shared<Report>(
+                report->getTopic(),
+                name,
+                report->getMaxParticipants()
+            );
+            
+            auto signedUpStudents = report->getSignedUpStudents();
+            for (int studentId : signedUpStudents) {
+                newReport->addStudent(studentId);
+            }
+            
+            if (report->getIsCompleted()) {
+                newReport->markAsCompleted();
+            }
+            
+            report = newReport;
+        }
+    }
+}
+
+void UniversitySystem::enrollStudentInSubject(int studentId, const string& identifier, ostream& out) {
+    unique_lock<RwLock> state(stateMutex);
     auto subject = findSubjectByNameOrCode(identifier);
     if (subject) {
         if (isStudentAlreadyEnrolled(studentId, subject->getName())) {
-            cout << "Студент ID " << studentId << " уже зачислен на предмет " << subject->getName() << endl;
+            out << "Студент ID " << studentId << " уже зачислен на предмет " << subject->getName() << endl;
             return;
         }
         
         subject->enrollStudent(studentId);
-        studentEnrollments[studentId].push_back(subject->getName());
-        subjectEnrollments[subject->getName()].push_back(studentId);
-        cout << "Студент ID " << studentId << " зачислен на предмет " << subject->getName() << endl;
-        saveAllData();
+        recordEnrollment(studentId, subject->getName());
+        out << "Студент ID " << studentId << " зачислен на предмет " << subject->getName() << endl;
+        logChange("ENROLL", {to_string(studentId), subject->getName()});
+        state.unlock();
+        commitChanges();
     } else {
-        cout << "Предмет не найден! Используйте название или код (например: $100)\n";
+        out << "Предмет не найден! Используйте название или код (например: $100)\n";
     }
 }
 
-vector<string> UniversitySystem::getStudentSubjects(int studentId) const {
+const set<Symbol>& UniversitySystem::getStudentSubjects(int studentId) const {
+    static const set<Symbol> noSubjects;
     auto it = studentEnrollments.find(studentId);
-    if (it != studentEnrollments.end()) {
-        return it->second;
-    }
-    return {};
+    return it != studentEnrollments.end() ? it->second : noSubjects;
 }
 
 void UniversitySystem::addAssignment(shared_ptr<Assignment> assignment) {
-    assignments.push_back(assignment);
-    saveAllData();
+    {
+        unique_lock<RwLock> state(stateMutex);
+        assignments.push_back(assignment);
+        auto subject = findSubject(assignment->getSubjectName());
+        if (subject) {
+            subject->setAssignmentMaxScore(SymbolTable::intern(assignment->getName()), assignment->getMaxScore());
+        }
+        logChange("ASSIGNMENT", {assignment->getName(), to_string(assignment->getMaxScore()),
+                                 assignment->getSubjectName()});
+    }
+    commitChanges();
 }
 
 void UniversitySystem::addReport(shared_ptr<Report> report) {
-    reports.push_back(report);
-    saveAllData();
+    {
+        unique_lock<RwLock> state(stateMutex);
+        reports.push_back(report);
+        logChange("REPORT", {report->getTopic(), report->getSubjectName(),
+                             to_string(report->getMaxParticipants())});
+    }
+    commitChanges();
 }
 
 bool UniversitySystem::submitReport(int studentId, const string& subjectName,
                                    const string& reportName) {
+    unique_lock<RwLock> state(stateMutex);
     auto subject = findSubject(subjectName);
+    Symbol reportId = SymbolTable::find(reportName);
     if (!subject || !subject->isStudentEnrolled(studentId) || 
-        !subject->hasReport(reportName)) {
+        !subject->hasReport(reportId)) {
         return false;
     }
     
     SubmissionRecord submission;
     submission.studentId = studentId;
-    submission.subjectName = subjectName;
-    submission.assignmentName = reportName;
+    submission.subjectId = subject->getId();
+    submission.itemId = reportId;
     submission.type = "report";
     submission.status = "pending";
     submission.timestamp = DataManager::getCurrentTimestamp();
     
-    submissions.push_back(submission);
-    saveAllData();
+    addSubmission(submission);
+    logChange("SUBMISSION", {to_string(studentId), subjectName, reportName,
+                             submission.type, submission.status, to_string(submission.timestamp)});
+    state.unlock();
+    commitChanges();
     return true;
 }
 
-bool UniversitySystem::gradeAssignment(int studentId, const string& subjectName,
-                                      const string& assignmentName, double grade) {
-    auto subject = findSubject(subjectName);
-    if (!subject || !subject->isStudentEnrolled(studentId)) {
-        cout << "Ошибка: студент не найден или не зачислен на предмет\n";
-        return false;
-    }
-    
-    if (!subject->hasAssignment(assignmentName)) {
-        cout << "Ошибка: задание '" << assignmentName << "' не существует\n";
-        return false;
-    }
-    
-    double maxScore = 100.0;
-    for (const auto& assignment : assignments) {
-        if (assignment->getName() == assignmentName && 
-            assignment->getSubjectName() == subjectName) {
-            maxScore = assignment->getMaxScore();
-            break;
-        }
-    }
-    
-    if (grade < 0 || grade > maxScore) {
-        cout << "Ошибка: оценка должна быть от 0 до " << maxScore << endl;
-        return false;
-    }
-    
-    if (subject->getStudentAssignmentGrade(studentId, assignmentName) >= 0) {
-        cout << "Ошибка: оценка за это задание уже выставлена\n";
-        return false;
-    }
-    
-    bool found = false;
-    for (auto& sub : submissions) {
-        if (sub.studentId == studentId && 
-            sub.subjectName == subjectName && 
-            sub.assignmentName == assignmentName &&
-            sub.type == "assignment") {
-            sub.status = "approved";
-            found = true;
-            break;
+void UniversitySystem::applyAssignmentGrade(Subject& subject, int studentId,
+                                            Symbol assignmentId, double grade, bool journal) {
+    const string& subjectName = subject.getName();
+    const string& assignmentName = SymbolTable::name(assignmentId);
+    // Без журнала изменение только отмечается и сохраняется контрольной точкой вызывающего
+    auto record = [&](const string& type, const vector<string>& fields) {
+        if (journal) {
+            logChange(type, fields);
+        } else {
+            markDirty(collectionsForChange(type));
         }
-    }
+    };
     
-    if (!found) {
+    auto existing = findSubmission(studentId, subject.getId(), assignmentId, "assignment");
+    if (existing) {
+        setSubmissionStatus(existing, "approved", existing->timestamp);
+        record("SUBMISSION", {to_string(studentId), subjectName, assignmentName,
+                              existing->type, existing->status, to_string(existing->timestamp)});
+    } else {
         SubmissionRecord submission;
         submission.studentId = studentId;
-        submission.subjectName = subjectName;
-        submission.assignmentName = assignmentName;
+        submission.subjectId = subject.getId();
+        submission.itemId = assignmentId;
         submission.type = "assignment";
         submission.status = "approved";
         submission.timestamp = DataManager::getCurrentTimestamp();
-        submissions.push_back(submission);
+        addSubmission(submission);
+        record("SUBMISSION", {to_string(studentId), subjectName, assignmentName,
+                              submission.type, submission.status, to_string(submission.timestamp)});
     }
     
-    subject->gradeAssignment(studentId, assignmentName, grade);
+    double previous = subject.getStudentAssignmentGrade(studentId, assignmentId);
+    subject.gradeAssignment(studentId, assignmentId, grade);
+    recordLeaderboardGrade(subject.getId(), studentId, previous,
+                           subject.getStudentAssignmentGrade(studentId, assignmentId));
     
     GradeRecord gradeRecord;
     gradeRecord.studentId = studentId;
-    gradeRecord.subjectName = subjectName;
-    gradeRecord.itemName = assignmentName;
+    gradeRecord.subjectId = subject.getId();
+    gradeRecord.itemId = assignmentId;
     gradeRecord.type = "assignment";
     gradeRecord.score = grade;
     gradeRecord.timestamp = DataManager::getCurrentTimestamp();
     
-    grades.push_back(gradeRecord);
-    cout << "Оценка " << grade << " успешно выставлена за задание '" << assignmentName 
-              << "' (макс. балл: " << maxScore << ")\n";
+    addGrade(gradeRecord);
+    record("GRADE", {to_string(studentId), subjectName, assignmentName, gradeRecord.type,
+                     to_string(grade), to_string(gradeRecord.timestamp)});
+    notifications.publish({studentId, gradeRecord.subjectId, gradeRecord.itemId, grade, gradeRecord.timestamp});
+}
+
+bool UniversitySystem::gradeAssignment(int studentId, const string& subjectName,
+                                      const string& assignmentName, double grade, ostream& out) {
+    if (needsOwner(subjectName)) {
+        return runOnSubject(subjectName, [&] {
+            return gradeAssignment(studentId, subjectName, assignmentName, grade, out);
+        }).get();
+    }
+    shared_lock<RwLock> state(stateMutex);
+    auto subject = findSubject(subjectName);
+    unique_lock<RwLock> subjectLock;
+    if (subject) {
+        subjectLock = lockSubject(*subject);
+    }
+    if (!subject || !subject->isStudentEnrolled(studentId)) {
+        out << "Ошибка: студент не найден или не зачислен на предмет\n";
+        return false;
+    }
     
-    auto student = findStudentById(studentId);
-    if (student) {
-        student->onGradeUpdated(subjectName, assignmentName, grade);
+    // Название разбирается один раз, дальше предмет работает с номером
+    Symbol assignmentId = SymbolTable::find(assignmentName);
+    if (!subject->hasAssignment(assignmentId)) {
+        out << "Ошибка: задание '" << assignmentName << "' не существует\n";
+        return false;
     }
     
-    saveAllData();
+    double maxScore = subject->getAssignmentMaxScore(assignmentId);
+    
+    if (grade < 0 || grade > maxScore) {
+        out << "Ошибка: оценка должна быть от 0 до " << maxScore << endl;
+        return false;
+    }
+    
+    if (subject->getStudentAssignmentGrade(studentId, assignmentId) >= 0) {
+        out << "Ошибка: оценка за это задание уже выставлена\n";
+        return false;
+    }
+    
+    unique_lock<RwLock> records(recordsMutex);
+    applyAssignmentGrade(*subject, studentId, assignmentId, grade, true);
+    records.unlock();
+    out << "Оценка " << grade << " успешно выставлена за задание '" << assignmentName 
+              << "' (макс. балл: " << maxScore << ")\n";
+    
+    if (subjectLock) subjectLock.unlock();
+    state.unlock();
+    commitChanges();
     return true;
 }
 
 bool UniversitySystem::submitAssignment(int studentId, const string& subjectName, 
-                                       const string& assignmentName) {
+                                       const string& assignmentName, ostream& out) {
+    if (needsOwner(subjectName)) {
+        return runOnSubject(subjectName, [&] {
+            return submitAssignment(studentId, subjectName, assignmentName, out);
+        }).get();
+    }
+    shared_lock<RwLock> state(stateMutex);
     auto subject = findSubject(subjectName);
+    unique_lock<RwLock> subjectLock;
+    if (subject) {
+        subjectLock = lockSubject(*subject);
+    }
     if (!subject || !subject->isStudentEnrolled(studentId)) {
-        cout << "Ошибка: студент не зачислен на предмет или предмет не найден\n";
+        out << "Ошибка: студент не зачислен на предмет или предмет не найден\n";
         return false;
     }
     
-    if (!subject->hasAssignment(assignmentName)) {
-        cout << "Ошибка: задание '" << assignmentName << "' не существует в предмете " << subjectName << endl;
+    Symbol assignmentId = SymbolTable::find(assignmentName);
+    if (!subject->hasAssignment(assignmentId)) {
+        out << "Ошибка: задание '" << assignmentName << "' не существует в предмете " << subjectName << endl;
         return false;
     }
     
-    bool canResubmit = false;
-    
-    for (const auto& sub : submissions) {
-        if (sub.studentId == studentId && 
-            sub.subjectName == subjectName && 
-            sub.assignmentName == assignmentName &&
-            sub.type == "assignment") {
-            
-            if (sub.status == "pending") {
-                cout << "Ошибка: вы уже отправили это задание и оно ожидает проверки\n";
-                return false;
-            } else if (sub.status == "rejected") {
-                canResubmit = true;
-            } else if (sub.status == "approved") {
-                if (subject->getStudentAssignmentGrade(studentId, assignmentName) >= 0) {
-                    cout << "Ошибка: за это задание уже выставлена оценка\n";
-                    return false;
-                }
-            }
-        }
+    unique_lock<RwLock> records(recordsMutex);
+    if (findSubmission(studentId, subject->getId(), assignmentId, "assignment", "pending")) {
+        out << "Ошибка: вы уже отправили это задание и оно ожидает проверки\n";
+        return false;
     }
     
-    if (subject->getStudentAssignmentGrade(studentId, assignmentName) >= 0) {
-        cout << "Ошибка: за это задание уже выставлена оценка\n";
+    if (subject->getStudentAssignmentGrade(studentId, assignmentId) >= 0) {
+        out << "Ошибка: за это задание уже выставлена оценка\n";
         return false;
     }
     
-    if (canResubmit) {
-        for (auto& sub : submissions) {
-            if (sub.studentId == studentId && 
-                sub.subjectName == subjectName && 
-                sub.assignmentName == assignmentName &&
-                sub.type == "assignment" &&
-                sub.status == "rejected") {
-                sub.status = "pending";
-                sub.timestamp = DataManager::getCurrentTimestamp();
-                cout << "Задание '" << assignmentName << "' успешно пересдано на проверку!\n";
-                saveAllData();
-                return true;
-            }
-        }
+    auto sub = findSubmission(studentId, subject->getId(), assignmentId, "assignment", "rejected");
+    if (sub) {
+        setSubmissionStatus(sub, "pending", DataManager::getCurrentTimestamp());
+        out << "Задание '" << assignmentName << "' успешно пересдано на проверку!\n";
+        logChange("SUBMISSION", {to_string(studentId), subjectName, assignmentName,
+                                 sub->type, sub->status, to_string(sub->timestamp)});
+        records.unlock();
+        if (subjectLock) subjectLock.unlock();
+        state.unlock();
+        commitChanges();
+        return true;
     }
     
     SubmissionRecord submission;
     submission.studentId = studentId;
-    submission.subjectName = subjectName;
-    submission.assignmentName = assignmentName;
+    submission.subjectId = subject->getId();
+    submission.itemId = assignmentId;
     submission.type = "assignment";
     submission.status = "pending";
     submission.timestamp = DataManager::getCurrentTimestamp();
     
-    submissions.push_back(submission);
-    cout << "Задание '" << assignmentName << "' успешно сдано на проверку!\n";
-    saveAllData();
+    addSubmission(submission);
+    out << "Задание '" << assignmentName << "' успешно сдано на проверку!\n";
+    logChange("SUBMISSION", {to_string(studentId), subjectName, assignmentName,
+                             submission.type, submission.status, to_string(submission.timestamp)});
+    records.unlock();
+    if (subjectLock) subjectLock.unlock();
+    state.unlock();
+    commitChanges();
     return true;
 }
 
 bool UniversitySystem::gradeReport(const string& identifier,
-                                  const string& reportName, double grade) {
+                                  const string& reportName, double grade, ostream& out) {
+    if (needsOwner(identifier)) {
+        return runOnSubject(identifier, [&] { return gradeReport(identifier, reportName, grade, out); }).get();
+    }
+    shared_lock<RwLock> state(stateMutex);
     auto subject = findSubjectByNameOrCode(identifier);
     if (!subject) {
-        cout << "Ошибка: предмет не найден\n";
+        out << "Ошибка: предмет не найден\n";
         return false;
     }
+    unique_lock<RwLock> subjectLock = lockSubject(*subject);
     
     string subjectName = subject->getName();
+    Symbol reportId = SymbolTable::find(reportName);
     
-    if (!subject->hasReport(reportName)) {
-        cout << "Ошибка: доклад '" << reportName << "' не существует\n";
+    if (!subject->hasReport(reportId)) {
+        out << "Ошибка: доклад '" << reportName << "' не существует\n";
         return false;
     }
     
-    bool hasGrades = false;
-    for (const auto& g : grades) {
-        if (g.type == "report" && g.itemName == reportName && 
-            g.subjectName == subjectName) {
-            hasGrades = true;
-            break;
-        }
-    }
-    
-    if (hasGrades) {
-        cout << "Ошибка: оценки за этот доклад уже выставлены\n";
+    if (subject->isReportGraded(reportId)) {
+        out << "Ошибка: оценки за этот доклад уже выставлены\n";
         return false;
     }
     
     if (grade < 0 || grade > 100) {
-        cout << "Ошибка: оценка должна быть от 0 до 100\n";
+        out << "Ошибка: оценка должна быть от 0 до 100\n";
         return false;
     }
     
+    unique_lock<RwLock> records(recordsMutex);
     auto report = findReportForSubject(subjectName, reportName);
     if (!report) {
-        cout << "Ошибка: информация о докладе не найдена\n";
+        out << "Ошибка: информация о докладе не найдена\n";
         return false;
     }
     
     auto participants = report->getSignedUpStudents();
     
     if (participants.empty()) {
-        cout << "Ошибка: на этот доклад не записан ни один студент\n";
+        out << "Ошибка: на этот доклад не записан ни один студент\n";
         return false;
     }
     
-    subject->gradeAllReports(reportName, grade, participants);
+    map<int, double> previousGrades;
+    for (int studentId : participants) {
+        previousGrades[studentId] = subject->getStudentReportGrade(studentId, reportId);
+    }
+    subject->gradeAllReports(reportId, grade, participants);
     
     int count = 0;
     for (int studentId : participants) {
         if (subject->isStudentEnrolled(studentId)) {
+            recordLeaderboardGrade(subject->getId(), studentId, previousGrades[studentId],
+                                   subject->getStudentReportGrade(studentId, reportId));
             GradeRecord gradeRecord;
             gradeRecord.studentId = studentId;
-            gradeRecord.subjectName = subjectName;
-            gradeRecord.itemName = reportName;
+            gradeRecord.subjectId = subject->getId();
+            gradeRecord.itemId = reportId;
             gradeRecord.type = "report";
             gradeRecord.score = grade;
             gradeRecord.timestamp = DataManager::getCurrentTimestamp();
             
-            grades.push_back(gradeRecord);
+            addGrade(gradeRecord);
+            logChange("GRADE", {to_string(studentId), subjectName, reportName, gradeRecord.type,
+                                to_string(grade), to_string(gradeRecord.timestamp)});
             count++;
             
-            auto student = findStudentById(studentId);
-            if (student) {
-                student->onGradeUpdated(subjectName, reportName, grade);
+            notifications.publish({studentId, gradeRecord.subjectId, gradeRecord.itemId, grade, gradeRecord.timestamp});
+        }
+    }
+    
+    out << "Оценка " << fixed << setprecision(2) << grade << " выставлена " 
+         << count << " студентам за доклад '" << reportName << "'\n";
+    records.unlock();
+    if (subjectLock) subjectLock.unlock();
+    state.unlock();
+    
+    // Удаление доклада меняет каталог: только под монопольным stateMutex. Пока блокировка
+    // была отпущена, доклад могли удалить или пересоздать - удаляем только оцененный
+    {
+        unique_lock<RwLock> catalog(stateMutex);
+        if (findReportForSubject(subjectName, reportName) == report) {
+            removeReport(subjectName, reportName);
+            unique_lock<RwLock> removal(recordsMutex);
+            logChange("REPORT_REMOVE", {subjectName, reportName});
+            out << "Доклад '" << reportName << "' удален\n";
+        }
+    }
+    commitChanges();
+    
+    return true;
+}
+
+vector<string> UniversitySystem::splitCsvLine(const string& line) {
+    vector<string> fields;
+    stringstream ss(line);
+    string field;
+    while (getline(ss, field, ',')) {
+        size_t first = field.find_first_not_of(" \t\r");
+        size_t last = field.find_last_not_of(" \t\r");
+        fields.push_back(first == string::npos ? string() : field.substr(first, last - first + 1));
+    }
+    return fields;
+}
+
+ImportReport UniversitySystem::importGrades(istream& csv, int professorId) {
+    struct Row {
+        size_t line;
+        int studentId;           // ID студента или -1, если студент указан именем
+        string student, subject, item;
+        double score;
+    };
+    struct ValidRow {
+        shared_ptr<Subject> subject;
+        int studentId;
+        Symbol assignmentId;
+        const Row* row;
+    };
+    
+    ImportReport report;
+    
+    // Разбор файла идет до захвата блокировок
+    vector<Row> rows;
+    string line;
+    size_t lineNumber = 0;
+    while (getline(csv, line)) {
+        lineNumber++;
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        vector<string> fields = splitCsvLine(line);
+        if (fields.size() != 4) {
+            report.failures.push_back({lineNumber, "ожидается 4 поля: студент, предмет, задание, оценка"});
+            continue;
+        }
+        // Поля разбираются так же, как при загрузке данных: без исключений и локали.
+        // Причины отказа не повторяют содержимое файла
+        double score = 0;
+        if (!parseDouble(fields[3], score) || !isfinite(score)) {
+            if (rows.empty() && report.failures.empty()) {
+                continue;   // Первая строка с нечисловой оценкой - заголовок
+            }
+            report.failures.push_back({lineNumber, "неверная оценка"});
+            continue;
+        }
+        int studentId = -1;
+        bool digitsOnly = !fields[0].empty() && fields[0].find_first_not_of("0123456789") == string::npos;
+        if (digitsOnly && !parseInt(fields[0], studentId)) {
+            report.failures.push_back({lineNumber, "неверный ID студента"});
+            continue;
+        }
+        rows.push_back({lineNumber, studentId, fields[0], fields[1], fields[2], score});
+    }
+    
+    {
+        // Монопольный захват: другие потоки видят либо ни одной, либо все оценки пакета
+        unique_lock<RwLock> state(stateMutex);
+        vector<ValidRow> valid;
+        map<tuple<int, Symbol, Symbol>, size_t> firstLine;   // Строка, где пара уже встречалась
+        for (const auto& row : rows) {
+            auto fail = [&](const string& reason) { report.failures.push_back({row.line, reason}); };
+            
+            shared_ptr<Student> student;
+            if (row.studentId >= 0) {
+                student = findStudentById(row.studentId);
+            } else {
+                auto it = users.find(row.student);
+                if (it != users.end()) {
+                    student = dynamic_pointer_cast<Student>(it->second);
+                }
+            }
+            if (!student) {
+                fail("студент не найден");
+                continue;
             }
+            auto subject = findSubjectByNameOrCode(row.subject);
+            if (!subject) {
+                fail("предмет не найден");
+                continue;
+            }
+            if (professorId >= 0 && !subject->isProfessor(professorId)) {
+                fail("вы не ведете предмет '" + subject->getName() + "'");
+                continue;
+            }
+            int studentId = student->getId();
+            if (!subject->isStudentEnrolled(studentId)) {
+                fail("студент " + student->getName() + " не зачислен на предмет " + subject->getName());
+                continue;
+            }
+            Symbol assignmentId = SymbolTable::find(row.item);
+            if (!subject->hasAssignment(assignmentId)) {
+                fail("задания нет в предмете " + subject->getName());
+                continue;
+            }
+            double maxScore = subject->getAssignmentMaxScore(assignmentId);
+            if (row.score < 0 || row.score > maxScore) {
+                ostringstream reason;
+                reason << "оценка должна быть от 0 до " << maxScore;
+                fail(reason.str());
+                continue;
+            }
+            if (subject->getStudentAssignmentGrade(studentId, assignmentId) >= 0) {
+                fail("оценка за это задание уже выставлена");
+                continue;
+            }
+            auto [it, inserted] = firstLine.emplace(make_tuple(studentId, subject->getId(), assignmentId), row.line);
+            if (!inserted) {
+                fail("повтор строки " + to_string(it->second));
+                continue;
+            }
+            valid.push_back({subject, studentId, assignmentId, &row});
         }
+        
+        for (const auto& entry : valid) {
+            applyAssignmentGrade(*entry.subject, entry.studentId, entry.assignmentId, entry.row->score, false);
+        }
+        report.applied = valid.size();
+        // Оценки пакета не пишутся в журнал: контрольная точка в той же монопольной секции,
+        // иначе чужая запись журнала успела бы лечь поверх несохраненного пакета
+        if (report.applied > 0) {
+            report.saved = saveAllDataLocked();
+        }
+    }
+    
+    sort(report.failures.begin(), report.failures.end());
+    return report;
+}
+
+ImportReport UniversitySystem::importRoster(istream& roster, int professorId) {
+    struct Row {
+        size_t line;
+        string name, passwordHash;
+        vector<string> subjects;
+    };
+    
+    ImportReport report;
+    
+    // Разбор и хэширование паролей идут до захвата блокировок
+    vector<Row> rows;
+    string line;
+    size_t lineNumber = 0;
+    while (getline(roster, line)) {
+        lineNumber++;
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        vector<string> fields = splitCsvLine(line);
+        if (fields.size() < 2 || fields[0].empty() || fields[1].empty()) {
+            report.failures.push_back({lineNumber, "ожидается: имя, пароль[, предмет...]"});
+            continue;
+        }
+        Row row{lineNumber, fields[0], User::hashPassword(fields[1]), {}};
+        for (size_t i = 2; i < fields.size(); i++) {
+            if (!fields[i].empty()) {
+                row.subjects.push_back(fields[i]);
+            }
+        }
+        rows.push_back(move(row));
+    }
+    
+    {
+        unique_lock<RwLock> state(stateMutex);
+        vector<pair<const Row*, vector<shared_ptr<Subject>>>> valid;
+        map<string, size_t> firstLine;   // Строка, где имя уже встречалось
+        for (const auto& row : rows) {
+            auto fail = [&](const string& reason) { report.failures.push_back({row.line, reason}); };
+            if (users.find(row.name) != users.end()) {
+                fail("пользователь с таким именем уже существует");
+                continue;
+            }
+            auto [it, inserted] = firstLine.emplace(row.name, row.line);
+            if (!inserted) {
+                fail("повтор строки " + to_string(it->second));
+                continue;
+            }
+            vector<shared_ptr<Subject>> subjectsToJoin;
+            string error;
+            for (const auto& identifier : row.subjects) {
+                auto subject = findSubjectByNameOrCode(identifier);
+                if (!subject) {
+                    error = "предмет не найден";
+                    break;
+                }
+                if (professorId >= 0 && !subject->isProfessor(professorId)) {
+                    error = "вы не ведете предмет '" + subject->getName() + "'";
+                    break;
+                }
+                subjectsToJoin.push_back(subject);
+            }
+            if (!error.empty()) {
+                firstLine.erase(it);
+                fail(error);
+                continue;
+            }
+            valid.push_back({&row, move(subjectsToJoin)});
+        }
+        
+        // Один блок ID на весь список вместо увеличения счетчика на каждого студента
+        int firstId = User::reserveIds(static_cast<int>(valid.size()));
+        for (size_t i = 0; i < valid.size(); i++) {
+            const Row& row = *valid[i].first;
+            int id = firstId + static_cast<int>(i);
+            auto student = Student::load(row.name, row.passwordHash, id);
+            users[row.name] = student;
+            students[id] = student;
+            for (const auto& subject : valid[i].second) {
+                subject->enrollStudent(id);
+                recordEnrollment(id, subject->getName());
+            }
+        }
+        markDirty(collectionsForChange("USER") | collectionsForChange("ENROLL"));
+        report.applied = valid.size();
+        // Как и в importGrades: студенты и записи пакета не журналируются и сохраняются здесь же
+        if (report.applied > 0) {
+            report.saved = saveAllDataLocked();
+        }
+    }
+    
+    sort(report.failures.begin(), report.failures.end());
+    return report;
+}
+
+bool UniversitySystem::importFromFile(const string& path, int professorId,
+                                      ImportReport (UniversitySystem::*import)(istream&, int),
+                                      const string& label) {
+    ifstream file(path);
+    if (!file) {
+        cout << "Не удалось открыть файл: " << path << endl;
+        return false;
+    }
+    return importAndReport(file, professorId, import, label);
+}
+
+bool UniversitySystem::importAndReport(istream& input, int professorId,
+                                       ImportReport (UniversitySystem::*import)(istream&, int),
+                                       const string& label, ostream& out) {
+    ImportReport report = (this->*import)(input, professorId);
+    out << label << report.applied << endl;
+    if (!report.failures.empty()) {
+        out << "Отклонено строк: " << report.failures.size() << endl;
+        for (const auto& [lineNumber, reason] : report.failures) {
+            out << "  строка " << lineNumber << ": " << reason << endl;
+        }
+    }
+    if (!report.saved) {
+        out << "Ошибка: импорт не сохранен на диск, повторная попытка будет при следующем сохранении\n";
+    }
+    return report.saved;
+}
+
+vector<SubmissionRecord> UniversitySystem::getPendingSubmissions(const string& subjectName) const {
+    shared_lock<RwLock> state(stateMutex);
+    shared_lock<RwLock> records(recordsMutex);
+    vector<SubmissionRecord> result;
+    if (subjectName.empty()) {
+        PendingQueue all;
+        for (const auto& [name, queue] : pendingBySubject) {
+            all.insert(queue.begin(), queue.end());
+        }
+        for (const auto& [timestamp, position] : all) {
+            result.push_back(submissions[position]);
+        }
+        return result;
+    }
+    
+    auto it = pendingBySubject.find(SymbolTable::find(subjectName));
+    if (it != pendingBySubject.end()) {
+        for (const auto& [timestamp, position] : it->second) {
+            result.push_back(submissions[position]);
+        }
+    }
+    return result;
+}
+
+vector<SubmissionRecord> UniversitySystem::getProfessorPendingSubmissions(int professorId) const {
+    shared_lock<RwLock> state(stateMutex);
+    shared_lock<RwLock> records(recordsMutex);
+    vector<SubmissionRecord> result;
+    auto it = pendingByProfessor.find(professorId);
+    if (it != pendingByProfessor.end()) {
+        for (const auto& [timestamp, position] : it->second) {
+            result.push_back(submissions[position]);
+        }
+    }
+    return result;
+}
+
+void UniversitySystem::listAllSubjects() const {
+    shared_lock<RwLock> state(stateMutex);
+    ostringstream out;   // Отчет собирается локально и выводится одной записью
+    out << "\nВсе предметы (" << subjects.size() << "):\n";
+    for (const auto& subject : subjects) {
+        out << "- " << subject->getName() 
+                  << " (" << subject->getCode() 
+                  << "), Преподаватель ID: " << subject->getProfessorId() << endl;
+    }
+    cout << out.str();
+}
+
+void UniversitySystem::listAllReports() const {
+    vector<shared_ptr<Report>> catalog;
+    {
+        shared_lock<RwLock> state(stateMutex);
+        catalog = reports;
+    }
+    ostringstream out;   // Отчет собирается локально и выводится одной записью
+    out << "\nВсе доклады (" << catalog.size() << "):\n";
+    for (const auto& report : catalog) {
+        size_t signedUp = readOnSubject(report->getSubjectName(), [&](const Subject*) {
+            return report->getSignedUpCount();
+        });
+        out << "- " << report->getTopic() 
+                  << " (Предмет: " << report->getSubjectName()
+                  << ", Участников: " << signedUp
+                  << "/" << report->getMaxParticipants() << ")\n";
+    }
+    cout << out.str();
+}
+
+void UniversitySystem::listAllStudents(ostream& out) const {
+    out << "\nВсе студенты (" << students.size() << "):\n";
+    for (const auto& [id, student] : students) {
+        out << "- " << student->getName() 
+                  << " (ID: " << id << ")\n";
+    }
+}
+
+void UniversitySystem::startSubjectWorkers(size_t workers) {
+    stopSubjectWorkers();
+    subjectWorkers = make_unique<ShardedExecutor>(workers);
+}
+
+void UniversitySystem::stopSubjectWorkers() {
+    subjectWorkers.reset();
+}
+
+bool UniversitySystem::needsOwner(const string& identifier) const {
+    return subjectWorkers && !subjectWorkers->isOwner(subjectKey(identifier));
+}
+
+unique_lock<RwLock> UniversitySystem::lockSubject(const Subject& subject) const {
+    return subjectWorkers ? unique_lock<RwLock>() : unique_lock<RwLock>(subject.getMutex());
+}
+
+shared_lock<RwLock> UniversitySystem::readSubject(const Subject& subject) const {
+    return subjectWorkers ? shared_lock<RwLock>() : shared_lock<RwLock>(subject.getMutex());
+}
+
+void UniversitySystem::recordLeaderboardGrade(Symbol subjectId, int studentId,
+                                              double previous, double grade) {
+    overallLeaderboard.recordGrade(studentId, previous, grade);
+    subjectLeaderboards[subjectId].recordGrade(studentId, previous, grade);
+}
+
+void UniversitySystem::rebuildLeaderboards() {
+    overallLeaderboard.clear();
+    subjectLeaderboards.clear();
+    for (const auto& subject : subjects) {
+        for (const auto& [studentId, itemId, grade] : subject->getAllGradeEntries()) {
+            recordLeaderboardGrade(subject->getId(), studentId, -1.0, grade);
+        }
+    }
+}
+
+void UniversitySystem::listAllProfessors() const {
+    cout << "\nВсе преподаватели (" << professors.size() << "):\n";
+    for (const auto& [id, professor] : professors) {
+        cout << "- " << professor->getName() 
+                  << " (ID: " << id << ")\n";
+    }
+}
+
+void UniversitySystem::showSubjectStatistics(const string& subjectName, ostream& out) const {
+    if (needsOwner(subjectName)) {
+        runOnSubject(subjectName, [&] { showSubjectStatistics(subjectName, out); }).get();
+        return;
+    }
+    shared_lock<RwLock> state(stateMutex);
+    ostringstream text;   // Отчет собирается локально и выводится одной записью
+    auto subject = findSubject(subjectName);
+    if (!subject) {
+        out << "Предмет не найден!\n";
+        return;
+    }
+    shared_lock<RwLock> subjectLock = readSubject(*subject);
+    
+    text << "\n=== Статистика по предмету " << subjectName << " ===\n";
+    
+    auto enrolled = subject->getEnrolledStudents();
+    text << "Всего студентов: " << enrolled.size() << endl;
+    
+    SubjectStats stats;
+    {
+        shared_lock<RwLock> records(recordsMutex);
+        auto it = subjectStats.find(SymbolTable::find(subjectName));
+        if (it != subjectStats.end()) {
+            stats = it->second;
+        }
+    }
+    
+    text << "Заданий сдано: " << stats.submitted << endl;
+    text << "Заданий на проверке: " << stats.pending << endl;
+    
+    if (stats.gradeCount > 0) {
+        double mean = stats.sum / stats.gradeCount;
+        double variance = max(0.0, stats.sumSquares / stats.gradeCount - mean * mean);
+        text << fixed << setprecision(2);
+        text << "Средняя оценка: " << mean << endl;
+        text << "Суммарная оценка: " << stats.sum << endl;
+        text << "Минимальная оценка: " << stats.min << endl;
+        text << "Максимальная оценка: " << stats.max << endl;
+        text << "Дисперсия оценок: " << variance << endl;
+        
+        // Распределение текущих оценок по журналу предмета (выше 100 - в последнюю корзину)
+        const int bucketWidth = 20;
+        auto histogram = subject->getScoreHistogram(0, 100, 100 / bucketWidth);
+        text << "Распределение оценок:\n";
+        for (size_t i = 0; i < histogram.size(); i++) {
+            text << "  " << setw(3) << i * bucketWidth << "-" << setw(3) << (i + 1) * bucketWidth
+                 << ": " << histogram[i] << endl;
+        }
+    }
+    out << text.str();
+}
+
+void UniversitySystem::showStudentSubjectSummary(int studentId, ostream& out) const {
+    ostringstream text;   // Отчет собирается локально и выводится одной записью
+    vector<string> subjectNames;
+    {
+        shared_lock<RwLock> state(stateMutex);
+        auto student = findStudentById(studentId);
+        if (!student) {
+            out << "Студент не найден!\n";
+            return;
+        }
+        
+        text << "\n=== ИТОГИ ПО ПРЕДМЕТАМ ДЛЯ " << student->getName() << " ===\n";
+        for (Symbol subjectId : getStudentSubjects(studentId)) {
+            subjectNames.push_back(SymbolTable::name(subjectId));
+        }
+    }
+    
+    if (subjectNames.empty()) {
+        text << "Студент не зачислен ни на один предмет.\n";
+        out << text.str();
+        return;
+    }
+    
+    double overallTotal = 0;
+    int overallCount = 0;
+    
+    // Предметы читаются по одному (в режиме акторов - в потоке владельца),
+    // пока ждем владельца, блокировки не удерживаются
+    for (const auto& subjectName : subjectNames) {
+        ScoreSummary summary = runOnSubject(subjectName, [&] {
+            shared_lock<RwLock> state(stateMutex);
+            auto subject = findSubject(subjectName);
+            if (!subject) return ScoreSummary();
+            shared_lock<RwLock> subjectLock = readSubject(*subject);
+            
+            text << "\nПредмет: " << subjectName << " (код: " << subject->getCode() << ")\n";
+            
+            auto gradesSummary = subject->getStudentGradesSummary(studentId);
+            
+            if (gradesSummary.empty()) {
+                text << "  Нет оценок\n";
+                return ScoreSummary();
+            }
+            
+            text << "  Оценки:\n";
+            for (const auto& [item, grade] : gradesSummary) {
+                text << "  - " << item << ": " << grade << endl;
+            }
+            
+            ScoreSummary summary = subject->getStudentScoreSummary(studentId);
+            text << "  Средний балл: " << fixed << setprecision(2) << summary.mean() << endl;
+            text << "  Суммарный балл: " << fixed << setprecision(2) << summary.sum << endl;
+            return summary;
+        }).get();
+        
+        overallTotal += summary.sum;
+        overallCount += summary.count;
+    }
+    
+    if (overallCount > 0) {
+        text << "\n=== ОБЩИЕ ИТОГИ ===\n";
+        text << "Всего предметов: " << subjectNames.size() << endl;
+        text << "Всего оценок: " << overallCount << endl;
+        text << "Cредний балл: " << fixed << setprecision(2) 
+                  << (overallTotal / subjectNames.size()) << endl;
+    }
+    out << text.str();
+}
+
+bool UniversitySystem::listStudentSubjects(int studentId, ostream& out) const {
+    shared_lock<RwLock> state(stateMutex);
+    const auto& studentSubjects = getStudentSubjects(studentId);
+    if (studentSubjects.empty()) {
+        out << "Вы не зачислены ни на один предмет.\n";
+        return false;
+    }
+    out << "Ваши предметы (" << studentSubjects.size() << "):\n";
+    for (Symbol subjectId : studentSubjects) {
+        const string& subject = SymbolTable::name(subjectId);
+        auto subj = findSubject(subjectId);
+        if (subj) {
+            out << "- " << subject << " (код: " << subj->getCode() << ")\n";
+        }
+    }
+    return true;
+}
+
+bool UniversitySystem::listProfessorSubjects(int professorId, ostream& out) const {
+    shared_lock<RwLock> state(stateMutex);
+    bool hasSubjects = false;
+    for (const auto& subject : subjects) {
+        if (subject->isProfessor(professorId)) {
+            out << "- " << subject->getName() 
+                      << " (код: " << subject->getCode() << ")\n";
+            hasSubjects = true;
+        }
+    }
+    return hasSubjects;
+}
+
+void UniversitySystem::listSubjectStudents(const Subject& subject, ostream& out) const {
+    for (int studentId : subject.getEnrolledStudents()) {
+        auto student = findStudentById(studentId);
+        if (student) {
+            out << "- " << student->getName() << " (ID: " << studentId << ")\n";
+        }
+    }
+}
+
+vector<shared_ptr<Report>> UniversitySystem::getAvailableReports(int studentId, ostream& out) const {
+    vector<shared_ptr<Report>> catalog;
+    {
+        shared_lock<RwLock> state(stateMutex);
+        catalog = reports;
+    }
+    vector<shared_ptr<Report>> availableReports;
+    out << "Список доступных докладов:\n";
+    for (const auto& report : catalog) {
+        // Запись на доклад проверяется у владельца предмета: ее меняет только он
+        size_t signedUp = 0;
+        bool available = readOnSubject(report->getSubjectName(), [&](const Subject*) {
+            signedUp = report->getSignedUpCount();
+            return isStudentAlreadyEnrolled(studentId, report->getSubjectName()) &&
+                   !report->isFull() && !report->hasStudent(studentId);
+        });
+        if (available) {
+            availableReports.push_back(report);
+            out << availableReports.size() << ". " << report->getTopic() 
+                      << " (Предмет: " << report->getSubjectName()
+                      << ", Участников: " << signedUp
+                      << "/" << report->getMaxParticipants() << ")\n";
+        }
+    }
+    return availableReports;
+}
+
+bool UniversitySystem::joinReport(int studentId, const shared_ptr<Report>& report, ostream& out) {
+    const string& subjectName = report->getSubjectName();
+    if (needsOwner(subjectName)) {
+        return runOnSubject(subjectName, [&] { return joinReport(studentId, report, out); }).get();
+    }
+    shared_lock<RwLock> state(stateMutex);
+    auto subject = findSubject(subjectName);
+    // Доклад могли оценить и удалить после того, как студент получил список
+    if (!subject || findReportForSubject(subjectName, report->getTopic()) != report) {
+        out << "Не могу записаться на доклад\n";
+        return false;
+    }
+    unique_lock<RwLock> subjectLock = lockSubject(*subject);
+    if (!report->addStudent(studentId)) {
+        out << "Не могу записаться на доклад\n";
+        return false;
+    }
+    out << "Успешно записался на доклад: " << report->getTopic() << endl;
+    {
+        unique_lock<RwLock> records(recordsMutex);
+        logChange("REPORT_JOIN", {subjectName, report->getTopic(), to_string(studentId)});
+    }
+    if (subjectLock) {
+        subjectLock.unlock();
+    }
+    state.unlock();
+    commitChanges();
+    return true;
+}
+
+bool UniversitySystem::leaveReport(int studentId, const string& topic, ostream& out) {
+    shared_ptr<Report> report;
+    {
+        shared_lock<RwLock> state(stateMutex);
+        report = findReport(topic);
+    }
+    if (!report) {
+        out << "Доклад с такой темой не найден.\n";
+        return false;
+    }
+    const string& subjectName = report->getSubjectName();
+    if (needsOwner(subjectName)) {
+        return runOnSubject(subjectName, [&] { return leaveReport(studentId, topic, out); }).get();
+    }
+    shared_lock<RwLock> state(stateMutex);
+    auto subject = findSubject(subjectName);
+    if (!subject || findReport(topic) != report) {
+        out << "Доклад с такой темой не найден.\n";
+        return false;
+    }
+    unique_lock<RwLock> subjectLock = lockSubject(*subject);
+    if (!report->removeStudent(studentId)) {
+        out << "Вы не записаны на этот доклад.\n";
+        return false;
+    }
+    out << "Отписался от доклада: " << topic << endl;
+    {
+        unique_lock<RwLock> records(recordsMutex);
+        logChange("REPORT_LEAVE", {subjectName, report->getTopic(), to_string(studentId)});
     }
-    
-    cout << "Оценка " << fixed << setprecision(2) << grade << " выставлена " 
-         << count << " студентам за доклад '" << reportName << "'\n";
-    
-    removeReport(subjectName, reportName);
-    cout << "Доклад '" << reportName << "' удален\n";
-    
-    saveAllData();
-    
+    if (subjectLock) {
+        subjectLock.unlock();
+    }
+    state.unlock();
+    commitChanges();
     return true;
 }
 
-vector<SubmissionRecord> UniversitySystem::getPendingSubmissions(const string& subjectName) const {
-    vector<SubmissionRecord> result;
-    for (const auto& sub : submissions) {
-        if (sub.status == "pending") {
-            if (subjectName.empty() || sub.subjectName == subjectName) {
-                result.push_back(sub);
-            }
-        }
+void UniversitySystem::takeOverSubject(int professorId, const shared_ptr<Subject>& existing,
+                                       const string& code, ostream& out) {
+    unique_lock<RwLock> state(stateMutex);
+    string name = existing->getName();
+    auto enrolledStudents = existing->getEnrolledStudentIds();
+    auto assignmentsList = existing->getAssignmentList();
+    auto reportsList = existing->getReportList();
+    
+    replaceSubjectProfessor(name, code, professorId);
+    logChange("SUBJECT", {name, code, to_string(professorId)});
+    
+    out << "Вы теперь преподаватель предмета '" << name << "'\n";
+    out << "Сохранено: " << enrolledStudents.size() << " студентов, " 
+              << assignmentsList.size() << " заданий, " 
+              << reportsList.size() << " докладов\n";
+    state.unlock();
+    commitChanges();
+}
+
+void UniversitySystem::createAssignment(const shared_ptr<Professor>& professor,
+                                        const shared_ptr<Subject>& subject,
+                                        const string& name, double maxScore, ostream& out) {
+    // Задание добавляется в предмет в потоке его владельца (без режима акторов - сразу)
+    auto assignment = runOnSubject(subject->getName(), [&] {
+        shared_lock<RwLock> state(stateMutex);
+        unique_lock<RwLock> subjectLock = lockSubject(*subject);
+        return professor->createAssignment(name, "", subject, out);
+    }).get();
+    assignment->setMaxScore(maxScore);
+    addAssignment(assignment);
+    out << "Задание '" << name << "' создано с максимальным баллом: " 
+              << maxScore << endl;
+}
+
+void UniversitySystem::createReport(const shared_ptr<Professor>& professor,
+                                    const shared_ptr<Subject>& subject,
+                                    const string& topic, int maxParticipants, ostream& out) {
+    auto report = runOnSubject(subject->getName(), [&] {
+        shared_lock<RwLock> state(stateMutex);
+        unique_lock<RwLock> subjectLock = lockSubject(*subject);
+        return professor->createReport(topic, subject, maxParticipants, out);
+    }).get();
+    addReport(report);
+}
+
+bool UniversitySystem::rejectSubmission(const SubmissionRecord& submission, ostream& out) {
+    shared_lock<RwLock> state(stateMutex);
+    unique_lock<RwLock> records(recordsMutex);
+    const string& subjectName = SymbolTable::name(submission.subjectId);
+    const string& assignmentName = SymbolTable::name(submission.itemId);
+    auto s = findSubmission(submission.studentId, submission.subjectId, submission.itemId, submission.type, "pending");
+    if (!s) {
+        return false;
     }
-    return result;
+    setSubmissionStatus(s, "rejected", s->timestamp);
+    out << "Работа отклонена. Студент может пересдать.\n";
+    logChange("SUBMISSION", {to_string(s->studentId), subjectName,
+                             assignmentName, s->type, s->status, to_string(s->timestamp)});
+    records.unlock();
+    state.unlock();
+    commitChanges();
+    return true;
 }
 
-void UniversitySystem::listAllSubjects() const {
-    cout << "\nВсе предметы (" << subjects.size() << "):\n";
-    for (const auto& subject : subjects) {
-        cout << "- " << subject->getName() 
-                  << " (" << subject->getCode() 
-                  << "), Преподаватель ID: " << subject->getProfessorId() << endl;
+bool UniversitySystem::printPendingList(const vector<SubmissionRecord>& pending, ostream& out) const {
+    if (pending.empty()) {
+        return false;
+    }
+    out << "Работы на проверку по вашим предметам (" << pending.size() << "):\n";
+    for (size_t i = 0; i < pending.size(); i++) {
+        const auto& sub = pending[i];
+        const string& subjectName = SymbolTable::name(sub.subjectId);
+        const string& assignmentName = SymbolTable::name(sub.itemId);
+        auto student = findStudentById(sub.studentId);
+        string studentName = student ? student->getName() : "Неизвестный";
+        
+        auto subSubject = findSubject(sub.subjectId);
+        double maxScore = subSubject ? subSubject->getAssignmentMaxScore(sub.itemId) : 100.0;
+        
+        out << i+1 << ". Студент: " << studentName 
+                  << " (ID: " << sub.studentId << ")"
+                  << ", Предмет: " << subjectName 
+                  << ", Задание: " << assignmentName 
+                  << " (макс. балл: " << maxScore << ")"
+                  << " (отправлено: " << DataManager::formatTimestamp(sub.timestamp) << ")\n";
     }
+    return true;
 }
 
-void UniversitySystem::listAllReports() const {
-    cout << "\nВсе доклады (" << reports.size() << "):\n";
-    for (const auto& report : reports) {
-        cout << "- " << report->getTopic() 
+double UniversitySystem::printSubmissionDetails(const SubmissionRecord& sub, ostream& out) const {
+    const string& subjectName = SymbolTable::name(sub.subjectId);
+    const string& assignmentName = SymbolTable::name(sub.itemId);
+    auto student = findStudentById(sub.studentId);
+    string studentName = student ? student->getName() : "Неизвестный";
+    
+    out << "\nВы выбрали работу:\n";
+    out << "Студент: " << studentName << " (ID: " << sub.studentId << ")\n";
+    out << "Предмет: " << subjectName << endl;
+    out << "Задание: " << assignmentName << endl;
+    
+    auto subSubject = findSubject(sub.subjectId);
+    double maxScore = subSubject ? subSubject->getAssignmentMaxScore(sub.itemId) : 100.0;
+    out << "Максимальный балл: " << maxScore << endl;
+    return maxScore;
+}
+
+bool UniversitySystem::printGradableReports(const vector<shared_ptr<Report>>& gradable, ostream& out) const {
+    if (gradable.empty()) {
+        return false;
+    }
+    out << "Доступные для оценки доклады по вашим предметам:\n";
+    for (size_t i = 0; i < gradable.size(); i++) {
+        const auto& report = gradable[i];
+        size_t signedUp = readOnSubject(report->getSubjectName(), [&](const Subject*) {
+            return report->getSignedUpCount();
+        });
+        out << i+1 << ". " << report->getTopic() 
                   << " (Предмет: " << report->getSubjectName()
-                  << ", Участников: " << report->getSignedUpCount()
-                  << "/" << report->getMaxParticipants() << ")\n";
+                  << ", Участников: " << signedUp << ")\n";
     }
+    return true;
 }
 
-void UniversitySystem::listAllStudents() const {
-    cout << "\nВсе студенты (" << students.size() << "):\n";
-    for (const auto& [id, student] : students) {
-        cout << "- " << student->getName() 
-                  << " (ID: " << id << ")\n";
+bool UniversitySystem::printReportParticipants(const Report& report, ostream& out) const {
+    ostringstream text;   // Список собирается у владельца предмета и выводится одной записью
+    bool hasParticipants = readOnSubject(report.getSubjectName(), [&](const Subject*) {
+        auto participants = report.getSignedUpStudents();
+        text << "Студенты, записанные на доклад '" << report.getTopic() << "':\n";
+        for (int studentId : participants) {
+            auto student = findStudentById(studentId);
+            if (student) {
+                text << "- " << student->getName() << " (ID: " << studentId << ")\n";
+            }
+        }
+        return !participants.empty();
+    });
+    if (!hasParticipants) {
+        return false;
     }
+    out << text.str();
+    return true;
 }
 
-void UniversitySystem::listAllProfessors() const {
-    cout << "\nВсе преподаватели (" << professors.size() << "):\n";
-    for (const auto& [id, professor] : professors) {
-        cout << "- " << professor->getName() 
-                  << " (ID: " << id << ")\n";
+vector<shared_ptr<Report>> UniversitySystem::getGradableReports(int professorId) const {
+    vector<shared_ptr<Report>> catalog;
+    {
+        shared_lock<RwLock> state(stateMutex);
+        catalog = reports;
+    }
+    vector<shared_ptr<Report>> professorReports;
+    for (const auto& report : catalog) {
+        // Отметку об оценке ставит gradeReport у владельца предмета
+        bool gradable = readOnSubject(report->getSubjectName(), [&](const Subject* subject) {
+            return subject && subject->isProfessor(professorId) &&
+                   !subject->isReportGraded(SymbolTable::find(report->getTopic()));
+        });
+        if (gradable) {
+            professorReports.push_back(report);
+        }
+    }
+    return professorReports;
+}
+
+void UniversitySystem::showFinalReport(const Subject& subject, ostream& out) const {
+    if (needsOwner(subject.getName())) {
+        runOnSubject(subject.getName(), [&] { showFinalReport(subject, out); }).get();
+        return;
+    }
+    shared_lock<RwLock> state(stateMutex);
+    shared_lock<RwLock> subjectLock = readSubject(subject);
+    ostringstream text;
+    map<int, string> studentNames;
+    for (int studentId : subject.getEnrolledStudents()) {
+        auto student = findStudentById(studentId);
+        if (student) {
+            studentNames[studentId] = student->getName();
+        }
     }
+    subject.generateFinalReport(studentNames, text);
+    out << text.str();
 }
 
-void UniversitySystem::showSubjectStatistics(const string& subjectName) const {
+void UniversitySystem::showStudentRanking(const string& subjectName, int studentId, ostream& out) const {
+    if (needsOwner(subjectName)) {
+        runOnSubject(subjectName, [&] { showStudentRanking(subjectName, studentId, out); }).get();
+        return;
+    }
+    shared_lock<RwLock> state(stateMutex);
+    ostringstream text;   // Отчет собирается локально и выводится одной записью
     auto subject = findSubject(subjectName);
     if (!subject) {
-        cout << "Предмет не найден!\n";
+        out << "Предмет не найден!\n";
         return;
     }
-    
-    cout << "\n=== Статистика по предмету " << subjectName << " ===\n";
-    
-    auto enrolled = subject->getEnrolledStudents();
-    cout << "Всего студентов: " << enrolled.size() << endl;
-    
-    int submitted = 0;
-    for (const auto& sub : submissions) {
-        if (sub.subjectName == subjectName && sub.type == "assignment") {
-            submitted++;
-        }
+    shared_lock<RwLock> subjectLock = readSubject(*subject);
+    auto student = findStudentById(studentId);
+    if (!student || !subject->isStudentEnrolled(studentId)) {
+        out << "Студент не зачислен на этот предмет!\n";
+        return;
     }
     
-    cout << "Заданий сдано: " << submitted << endl;
-    cout << "Заданий на проверке: " 
-              << getPendingSubmissions(subjectName).size() << endl;
+    const ScoreRanking& total = subject->getTotalRanking();
+    text << "\n=== РЕЙТИНГ: " << student->getName() << ", " << subjectName << " ===\n";
+    text << fixed << setprecision(2);
+    if (total.size() > 0) {
+        text << "Сумма баллов по предмету: медиана " << total.median()
+             << ", квартили " << total.quantile(0.25) << " / " << total.quantile(0.75)
+             << ", лучший " << total.kth(0) << endl;
+    }
+    if (!total.contains(studentId)) {
+        text << "У студента нет оценок по предмету.\n";
+        out << text.str();
+        return;
+    }
+    text << "Сумма студента: " << total.score(studentId)
+         << ", место " << total.rank(studentId) << " из " << total.size()
+         << ", процентиль " << total.percentile(studentId) << endl;
     
-    double total = 0;
-    int count = 0;
-    for (const auto& grade : grades) {
-        if (grade.subjectName == subjectName) {
-            total += grade.score;
-            count++;
+    auto showItem = [studentId, &text](const string& label, const string& item, const ScoreRanking* ranking) {
+        if (!ranking || !ranking->contains(studentId)) {
+            return;
         }
+        text << "  " << label << item << ": " << ranking->score(studentId)
+             << ", место " << ranking->rank(studentId) << " из " << ranking->size()
+             << ", медиана " << ranking->median() << endl;
+    };
+    for (Symbol assignmentId : subject->getAssignments()) {
+        showItem("Задание: ", SymbolTable::name(assignmentId), subject->getAssignmentRanking(assignmentId));
     }
-    
-    if (count > 0) {
-        cout << "Средняя оценка: " << (total / count) << endl;
-        cout << "Суммарная оценка: " << total << endl;
+    for (const auto& [reportName, grade] : subject->getStudentReportGrades(studentId)) {
+        showItem("Доклад: ", reportName, subject->getReportRanking(SymbolTable::find(reportName)));
     }
+    out << text.str();
 }
 
-void UniversitySystem::showStudentSubjectSummary(int studentId) const {
-    auto student = findStudentById(studentId);
-    if (!student) {
-        cout << "Студент не найден!\n";
-        return;
+vector<pair<int, double>> UniversitySystem::getTopStudents(size_t k, const string& subjectName) const {
+    shared_lock<RwLock> records(recordsMutex);
+    if (subjectName.empty()) {
+        return overallLeaderboard.top(k);
     }
-    
-    cout << "\n=== ИТОГИ ПО ПРЕДМЕТАМ ДЛЯ " << student->getName() << " ===\n";
-    
-    auto studentSubjects = getStudentSubjects(studentId);
-    if (studentSubjects.empty()) {
-        cout << "Студент не зачислен ни на один предмет.\n";
+    auto it = subjectLeaderboards.find(SymbolTable::find(subjectName));
+    return it != subjectLeaderboards.end() ? it->second.top(k) : vector<pair<int, double>>();
+}
+
+void UniversitySystem::showLeaderboard(size_t k, const string& subjectName, ostream& out) const {
+    auto top = getTopStudents(k, subjectName);
+    out << "\n=== ЛУЧШИЕ СТУДЕНТЫ" << (subjectName.empty() ? "" : ": " + subjectName) << " ===\n";
+    if (top.empty()) {
+        out << "Оценок пока нет.\n";
         return;
     }
-    
-    set<string> uniqueSubjects;
-    for (const auto& subject : studentSubjects) {
-        uniqueSubjects.insert(subject);
+    for (size_t i = 0; i < top.size(); i++) {
+        auto student = findStudentById(top[i].first);
+        string studentName = student ? student->getName() : "Неизвестный";
+        out << setw(3) << i + 1 << ". " << studentName << " (ID: " << top[i].first << ")"
+             << " - средний балл " << fixed << setprecision(2) << top[i].second << endl;
+    }
+}
+
+string UniversitySystem::executeRequest(ClientSession& session, const vector<string>& request, ostream& out) {
+    const string& command = request[0];
+    auto arg = [&request](size_t i) -> const string& {
+        static const string missing;
+        return i < request.size() ? request[i] : missing;
+    };
+    auto status = [](bool success) { return success ? "OK" : "ERR"; };
+    // Номер из последнего показанного списка (с 1) -> индекс или -1
+    auto pick = [](size_t listed, const string& number) {
+        int n = stoi(number);
+        return n > 0 && n <= static_cast<int>(listed) ? n - 1 : -1;
+    };
+    
+    if (command == "LOGIN") {
+        if (session.user) {
+            out << "Сессия уже открыта пользователем " << session.user->getName() << endl;
+            return "ERR";
+        }
+        return status(login(arg(1), arg(2), session.user, out));
+    }
+    if (command == "REGISTER") {
+        if (arg(3) != "1" && arg(3) != "2") {
+            out << "Неверный выбор!\n";
+            return "ERR";
+        }
+        User::Role role = arg(3) == "1" ? User::Role::STUDENT : User::Role::PROFESSOR;
+        return status(registerUser(arg(1), arg(2), role, out));
+    }
+    if (!session.user) {
+        out << "Сначала войдите в систему\n";
+        return "ERR";
+    }
+    if (command == "ROLE") {
+        out << (session.user->getRole() == User::Role::STUDENT ? "student" : "professor");
+        return "OK";
+    }
+    if (command == "LOGOUT") {
+        logout(session.user, out);
+        saveAllData();
+        session.listedReports.clear();
+        session.listedSubmissions.clear();
+        session.importBuffer.clear();
+        return "OK";
     }
     
-    double overallTotal = 0;
-    int overallCount = 0;
+    if (auto student = dynamic_pointer_cast<Student>(session.user)) {
+        int studentId = student->getId();
+        if (command == "MY_SUBJECTS") {
+            return status(listStudentSubjects(studentId, out));
+        }
+        if (command == "SUBJECT_ASSIGNMENTS" || command == "SUBMIT") {
+            auto subject = findSubjectByNameOrCode(arg(1));
+            if (!subject) {
+                out << "Предмет не найден! Используйте название или код.\n";
+                return "ERR";
+            }
+            if (command == "SUBMIT") {
+                return status(submitAssignment(studentId, subject->getName(), arg(2), out));
+            }
+            auto assignments = subject->getAssignments();
+            if (assignments.empty()) {
+                out << "В этом предмете нет заданий.\n";
+                return "ERR";
+            }
+            out << "Доступные задания:\n";
+            for (Symbol assignmentId : assignments) {
+                out << "- " << SymbolTable::name(assignmentId) << endl;
+            }
+            return "OK";
+        }
+        if (command == "AVAILABLE_REPORTS") {
+            session.listedReports = getAvailableReports(studentId, out);
+            if (session.listedReports.empty()) {
+                out << "Нет доступных докладов по вашим предметам.\n";
+                return "ERR";
+            }
+            return "OK";
+        }
+        if (command == "JOIN_REPORT") {
+            int index = pick(session.listedReports.size(), arg(1));
+            if (index < 0) {
+                out << "Неверный номер доклада!\n";
+                return "ERR";
+            }
+            return status(joinReport(studentId, session.listedReports[index], out));
+        }
+        if (command == "LEAVE_REPORT") {
+            return status(leaveReport(studentId, arg(1), out));
+        }
+        if (command == "SUMMARY") {
+            showStudentSubjectSummary(studentId, out);
+            return "OK";
+        }
+    }
     
-    for (const auto& subjectName : uniqueSubjects) {
-        auto subject = findSubject(subjectName);
-        if (!subject) continue;
-        
-        cout << "\nПредмет: " << subjectName << " (код: " << subject->getCode() << ")\n";
-        
-        auto gradesSummary = subject->getStudentGradesSummary(studentId);
+    if (auto professor = dynamic_pointer_cast<Professor>(session.user)) {
+        int professorId = professor->getId();
+        auto ownSubject = [this, professorId, &out](const string& identifier) {
+            auto subject = findSubjectByNameOrCode(identifier);
+            if (!subject || !subject->isProfessor(professorId)) {
+                out << "Предмет не найден или вы не ведете его!\n";
+                return shared_ptr<Subject>();
+            }
+            return subject;
+        };
         
-        if (gradesSummary.empty()) {
-            cout << "  Нет оценок\n";
-            continue;
+        if (command == "PROF_SUBJECTS") {
+            return status(listProfessorSubjects(professorId, out));
         }
-        
-        double subjectTotal = 0;
-        int subjectCount = 0;
-        
-        cout << "  Оценки:\n";
-        for (const auto& [item, grade] : gradesSummary) {
-            cout << "  - " << item << ": " << grade << endl;
-            subjectTotal += grade;
-            subjectCount++;
+        if (command == "CREATE_SUBJECT") {
+            auto existingSubject = findSubject(arg(1));
+            if (!existingSubject) {
+                addSubject(professor->createSubject(arg(1), arg(2), professorId, out));
+                return "OK";
+            }
+            if (arg(3) != "replace") {
+                out << "\nВнимание: предмет '" << arg(1) << "' уже существует!\n";
+                out << "Текущий преподаватель: ID " << existingSubject->getProfessorId() << endl;
+                out << "Вы хотите стать преподавателем этого предмета?\n";
+                return "CONFIRM";
+            }
+            takeOverSubject(professorId, existingSubject, arg(2), out);
+            return "OK";
+        }
+        if (command == "CREATE_ASSIGNMENT") {
+            auto subject = ownSubject(arg(1));
+            if (!subject) return "ERR";
+            if (subject->hasAssignment(SymbolTable::find(arg(2)))) {
+                out << "Задание с таким названием уже существует!\n";
+                return "ERR";
+            }
+            createAssignment(professor, subject, arg(2), stod(arg(3)), out);
+            return "OK";
+        }
+        if (command == "CREATE_REPORT") {
+            auto subject = ownSubject(arg(1));
+            if (!subject) return "ERR";
+            createReport(professor, subject, arg(2), stoi(arg(3)), out);
+            return "OK";
+        }
+        if (command == "STUDENTS") {
+            listAllStudents(out);
+            return "OK";
+        }
+        if (command == "ENROLL") {
+            auto subject = ownSubject(arg(2));
+            if (!subject) return "ERR";
+            enrollStudentInSubject(stoi(arg(1)), arg(2), out);
+            return "OK";
+        }
+        if (command == "PENDING") {
+            session.listedSubmissions = getProfessorPendingSubmissions(professorId);
+            if (!printPendingList(session.listedSubmissions, out)) {
+                out << "Нет работ на проверку по вашим предметам.\n";
+                return "ERR";
+            }
+            return "OK";
+        }
+        if (command == "SUBMISSION" || command == "APPROVE" || command == "REJECT") {
+            int index = pick(session.listedSubmissions.size(), arg(1));
+            if (index < 0) {
+                out << "Неверный номер работы!\n";
+                return "ERR";
+            }
+            const auto& sub = session.listedSubmissions[index];
+            if (command == "SUBMISSION") {
+                printSubmissionDetails(sub, out);
+                return "OK";
+            }
+            if (command == "REJECT") {
+                return status(rejectSubmission(sub, out));
+            }
+            return status(gradeAssignment(sub.studentId, SymbolTable::name(sub.subjectId),
+                                          SymbolTable::name(sub.itemId), stod(arg(2)), out));
+        }
+        if (command == "GRADABLE_REPORTS") {
+            session.listedReports = getGradableReports(professorId);
+            if (!printGradableReports(session.listedReports, out)) {
+                out << "Нет докладов для оценки по вашим предметам.\n";
+                return "ERR";
+            }
+            return "OK";
+        }
+        if (command == "REPORT_PARTICIPANTS" || command == "GRADE_REPORT") {
+            int index = pick(session.listedReports.size(), arg(1));
+            if (index < 0) {
+                out << "Неверный номер доклада!\n";
+                return "ERR";
+            }
+            const auto& report = session.listedReports[index];
+            if (command == "GRADE_REPORT") {
+                return status(gradeReport(report->getSubjectName(), report->getTopic(), stod(arg(2)), out));
+            }
+            if (!printReportParticipants(*report, out)) {
+                out << "На этот доклад не записан ни один студент.\n";
+                return "ERR";
+            }
+            return "OK";
+        }
+        if (command == "STATS" || command == "FINAL_REPORT" ||
+            command == "SUBJECT_STUDENTS" || command == "RANKING") {
+            auto subject = ownSubject(arg(1));
+            if (!subject) return "ERR";
+            if (command == "STATS") {
+                showSubjectStatistics(subject->getName(), out);
+            } else if (command == "FINAL_REPORT") {
+                showFinalReport(*subject, out);
+            } else if (command == "SUBJECT_STUDENTS") {
+                listSubjectStudents(*subject, out);
+            } else {
+                showStudentRanking(subject->getName(), stoi(arg(2)), out);
+            }
+            return "OK";
+        }
+        if (command == "TOP") {
+            size_t k = max(stoi(arg(1)), 0);
+            if (arg(2).empty()) {
+                showLeaderboard(k, "", out);
+                return "OK";
+            }
+            auto subject = findSubjectByNameOrCode(arg(2));
+            if (!subject) {
+                out << "Предмет не найден!\n";
+                return "ERR";
+            }
+            showLeaderboard(k, subject->getName(), out);
+            return "OK";
+        }
+        if (command == "IMPORT_LINE") {
+            // Файл читает клиент и передает построчно; табуляции внутри строки разделили ее на поля
+            string line;
+            for (size_t i = 1; i < request.size(); i++) {
+                line += (i > 1 ? "\t" : "") + request[i];
+            }
+            if (session.importBuffer.size() + line.size() + 1 > MAX_IMPORT_BYTES) {
+                session.importBuffer.clear();
+                out << "Файл импорта слишком большой\n";
+                return "ERR";
+            }
+            session.importBuffer += line + "\n";
+            return "OK";
+        }
+        if (command == "IMPORT_GRADES") {
+            istringstream csv(move(session.importBuffer));
+            session.importBuffer.clear();
+            return status(importAndReport(csv, professorId, &UniversitySystem::importGrades,
+                                          "Импортировано оценок: ", out));
+        }
+        if (command == "IMPORT_ROSTER") {
+            istringstream roster(move(session.importBuffer));
+            session.importBuffer.clear();
+            return status(importAndReport(roster, professorId, &UniversitySystem::importRoster,
+                                          "Зарегистрировано студентов: ", out));
         }
-        
-        double subjectAverage = subjectTotal / subjectCount;
-        cout << "  Средний балл: " << fixed << setprecision(2) << subjectAverage << endl;
-        cout << "  Суммарный балл: " << fixed << setprecision(2) << subjectTotal << endl;
-        
-        overallTotal += subjectTotal;
-        overallCount += subjectCount;
     }
     
-    if (overallCount > 0) {
-        cout << "\n=== ОБЩИЕ ИТОГИ ===\n";
-        cout << "Всего предметов: " << uniqueSubjects.size() << endl;
-        cout << "Всего оценок: " << overallCount << endl;
-        cout << "Cредний балл: " << fixed << setprecision(2) 
-                  << (overallTotal / uniqueSubjects.size()) << endl;
-    }
+    out << "Неизвестная команда: " << command << endl;
+    return "ERR";
 }
 
 void UniversitySystem::runStudentMenu(shared_ptr<Student> student) {
@@ -856,34 +2401,20 @@ void UniversitySystem::runStudentMenu(shared_ptr<Student> student) {
         
         switch (choice) {
             case 1: {
-                auto studentSubjects = getStudentSubjects(student->getId());
-                if (studentSubjects.empty()) {
-                    cout << "Вы не зачислены ни на один предмет.\n";
-                } else {
-                    cout << "Ваши предметы (" << studentSubjects.size() << "):\n";
-                    set<string> uniqueSubjects;
-                    for (const auto& subject : studentSubjects) {
-                        uniqueSubjects.insert(subject);
-                    }
-                    for (const auto& subject : uniqueSubjects) {
-                        auto subj = findSubject(subject);
-                        if (subj) {
-                            cout << "- " << subject << " (код: " << subj->getCode() << ")\n";
-                        }
-                    }
-                }
+                listStudentSubjects(student->getId());
                 break;
             }
             case 2: {
-                auto studentSubjects = getStudentSubjects(student->getId());
+                const auto& studentSubjects = getStudentSubjects(student->getId());
                 if (studentSubjects.empty()) {
                     cout << "Вы не зачислены ни на один предмет.\n";
                     break;
                 }
                 
                 cout << "Ваши предметы:\n";
-                for (const auto& subjectName : studentSubjects) {
-                    auto subj = findSubject(subjectName);
+                for (Symbol subjectId : studentSubjects) {
+                    const string& subjectName = SymbolTable::name(subjectId);
+                    auto subj = findSubject(subjectId);
                     if (subj) {
                         cout << "- " << subjectName << " (код: " << subj->getCode() << ")\n";
                     }
@@ -900,8 +2431,8 @@ void UniversitySystem::runStudentMenu(shared_ptr<Student> student) {
                         cout << "В этом предмете нет заданий.\n";
                     } else {
                         cout << "Доступные задания:\n";
-                        for (const auto& a : assignments) {
-                            cout << "- " << a << endl;
+                        for (Symbol assignmentId : assignments) {
+                            cout << "- " << SymbolTable::name(assignmentId) << endl;
                         }
                         
                         cout << "Введите название задания: ";
@@ -916,31 +2447,14 @@ void UniversitySystem::runStudentMenu(shared_ptr<Student> student) {
                 break;
             }
             case 3: {
-                auto studentSubjects = getStudentSubjects(student->getId());
+                const auto& studentSubjects = getStudentSubjects(student->getId());
                 if (studentSubjects.empty()) {
                     cout << "Вы не зачислены ни на один предмет.\n";
                     break;
                 }
                 
-                cout << "Список доступных докладов:\n";
-                bool hasReports = false;
-                int counter = 1;
-                vector<shared_ptr<Report>> availableReports;
-                
-                for (const auto& report : reports) {
-                    if (find(studentSubjects.begin(), studentSubjects.end(), 
-                                 report->getSubjectName()) != studentSubjects.end() &&
-                        !report->isFull() && !report->hasStudent(student->getId())) {
-                        cout << counter++ << ". " << report->getTopic() 
-                                  << " (Предмет: " << report->getSubjectName()
-                                  << ", Участников: " << report->getSignedUpCount()
-                                  << "/" << report->getMaxParticipants() << ")\n";
-                        availableReports.push_back(report);
-                        hasReports = true;
-                    }
-                }
-                
-                if (!hasReports) {
+                auto availableReports = getAvailableReports(student->getId());
+                if (availableReports.empty()) {
                     cout << "Нет доступных докладов по вашим предметам.\n";
                     break;
                 }
@@ -951,13 +2465,7 @@ void UniversitySystem::runStudentMenu(shared_ptr<Student> student) {
                 cin.ignore();
                 
                 if (reportNum > 0 && reportNum <= static_cast<int>(availableReports.size())) {
-                    auto report = availableReports[reportNum-1];
-                    if (report->addStudent(student->getId())) {
-                        cout << "Успешно записался на доклад: " << report->getTopic() << endl;
-                        saveAllData();
-                    } else {
-                        cout << "Не могу записаться на доклад\n";
-                    }
+                    joinReport(student->getId(), availableReports[reportNum-1]);
                 } else {
                     cout << "Неверный номер доклада!\n";
                 }
@@ -968,17 +2476,7 @@ void UniversitySystem::runStudentMenu(shared_ptr<Student> student) {
                 string reportTopic;
                 getline(cin, reportTopic);
                 
-                auto report = findReport(reportTopic);
-                if (report) {
-                    if (report->removeStudent(student->getId())) {
-                        cout << "Отписался от доклада: " << reportTopic << endl;
-                        saveAllData();
-                    } else {
-                        cout << "Вы не записаны на этот доклад.\n";
-                    }
-                } else {
-                    cout << "Доклад с такой темой не найден.\n";
-                }
+                leaveReport(student->getId(), reportTopic);
                 break;
             }
             case 5: {
@@ -986,7 +2484,7 @@ void UniversitySystem::runStudentMenu(shared_ptr<Student> student) {
                 break;
             }
             case 6:
-                logout();
+                logout(currentUser);
                 saveAllData();
                 return;
             default:
@@ -1000,16 +2498,7 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
         cout << "\n=== МЕНЮ ПРЕПОДАВАТЕЛЯ ===\n";
         cout << "Ваши предметы:\n";
         
-        bool hasSubjects = false;
-        for (const auto& subject : subjects) {
-            if (subject->isProfessor(professor->getId())) {
-                cout << "- " << subject->getName() 
-                          << " (код: " << subject->getCode() << ")\n";
-                hasSubjects = true;
-            }
-        }
-        
-        if (!hasSubjects) {
+        if (!listProfessorSubjects(professor->getId())) {
             cout << "  (нет предметов)\n";
         }
         
@@ -1021,7 +2510,11 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
         cout << "6. Выставить оценку за доклад\n";
         cout << "7. Просмотреть статистику предмета\n";
         cout << "8. Создать итоговый отчет\n";
-        cout << "9. Выход из системы\n";
+        cout << "9. Рейтинг студента по предмету\n";
+        cout << "10. Лучшие студенты\n";
+        cout << "11. Импорт оценок из CSV\n";
+        cout << "12. Импорт списка студентов\n";
+        cout << "13. Выход из системы\n";
         cout << "Выберите действие: ";
         
         int choice;
@@ -1050,60 +2543,7 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                     cin.ignore();
                     
                     if (choice == 1) {
-                        auto enrolledStudents = existingSubject->getEnrolledStudentIds();
-                        auto assignmentsList = existingSubject->getAssignmentList();
-                        auto reportsList = existingSubject->getReportList();
-                        auto assignmentGrades = existingSubject->getAllAssignmentGrades();
-                        auto reportGrades = existingSubject->getAllReportGrades();
-                        
-                        auto newSubject = make_shared<Subject>(name, code, professor->getId());
-                        
-                        for (int studentId : enrolledStudents) {
-                            newSubject->enrollStudent(studentId);
-                        }
-                        
-                        newSubject->setAssignmentGrades(assignmentGrades);
-                        newSubject->setReportGrades(reportGrades);
-                        
-                        for (auto& subject : subjects) {
-                            if (subject->getName() == name) {
-                                subject = newSubject;
-                                break;
-                            }
-                        }
-                        
-                        for (auto& assignment : assignments) {
-                            if (assignment->getSubjectName() == name) {
-                                assignment->setSubjectName(name);
-                            }
-                        }
-                        
-                        for (auto& report : reports) {
-                            if (report->getSubjectName() == name) {
-                                auto newReport = make_shared<Report>(
-                                    report->getTopic(),
-                                    name,
-                                    report->getMaxParticipants()
-                                );
-                                
-                                auto signedUpStudents = report->getSignedUpStudents();
-                                for (int studentId : signedUpStudents) {
-                                    newReport->addStudent(studentId);
-                                }
-                                
-                                if (report->getIsCompleted()) {
-                                    newReport->markAsCompleted();
-                                }
-                                
-                                report = newReport;
-                            }
-                        }
-                        
-                        cout << "Вы теперь преподаватель предмета '" << name << "'\n";
-                        cout << "Сохранено: " << enrolledStudents.size() << " студентов, " 
-                                  << assignmentsList.size() << " заданий, " 
-                                  << reportsList.size() << " докладов\n";
-                        saveAllData();
+                        takeOverSubject(professor->getId(), existingSubject, code);
                     } else {
                         cout << "Создание предмета отменено.\n";
                     }
@@ -1115,17 +2555,8 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                 break;
             }
             case 2: {
-                bool hasSubjects = false;
                 cout << "Ваши предметы:\n";
-                for (const auto& subject : subjects) {
-                    if (subject->isProfessor(professor->getId())) {
-                        cout << "- " << subject->getName() 
-                                  << " (код: " << subject->getCode() << ")\n";
-                        hasSubjects = true;
-                    }
-                }
-                
-                if (!hasSubjects) {
+                if (!listProfessorSubjects(professor->getId())) {
                     cout << "У вас нет предметов. Сначала создайте предмет.\n";
                     break;
                 }
@@ -1140,32 +2571,23 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                     double maxScore;
                     cout << "Название задания: ";
                     getline(cin, name);
+                    if (subject->hasAssignment(SymbolTable::find(name))) {
+                        cout << "Задание с таким названием уже существует!\n";
+                        break;
+                    }
                     cout << "Максимальный балл: ";
                     cin >> maxScore;
                     cin.ignore();
                     
-                    auto assignment = professor->createAssignment(name, "", subject);
-                    assignment->setMaxScore(maxScore);
-                    addAssignment(assignment);
-                    cout << "Задание '" << name << "' создано с максимальным баллом: " 
-                              << maxScore << endl;
+                    createAssignment(professor, subject, name, maxScore);
                 } else {
                     cout << "Предмет не найден или вы не ведете его!\n";
                 }
                 break;
             }
             case 3: {
-                bool hasSubjects = false;
                 cout << "Ваши предметы:\n";
-                for (const auto& subject : subjects) {
-                    if (subject->isProfessor(professor->getId())) {
-                        cout << "- " << subject->getName() 
-                                  << " (код: " << subject->getCode() << ")\n";
-                        hasSubjects = true;
-                    }
-                }
-                
-                if (!hasSubjects) {
+                if (!listProfessorSubjects(professor->getId())) {
                     cout << "У вас нет предметов. Сначала создайте предмет.\n";
                     break;
                 }
@@ -1184,25 +2606,15 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                     cin >> maxParticipants;
                     cin.ignore();
                     
-                    auto report = professor->createReport(topic, subject, maxParticipants);
-                    addReport(report);
+                    createReport(professor, subject, topic, maxParticipants);
                 } else {
                     cout << "Предмет не найден или вы не ведете его!\n";
                 }
                 break;
             }
             case 4: {
-                bool hasSubjects = false;
                 cout << "Ваши предметы:\n";
-                for (const auto& subject : subjects) {
-                    if (subject->isProfessor(professor->getId())) {
-                        cout << "- " << subject->getName() 
-                                  << " (код: " << subject->getCode() << ")\n";
-                        hasSubjects = true;
-                    }
-                }
-                
-                if (!hasSubjects) {
+                if (!listProfessorSubjects(professor->getId())) {
                     cout << "У вас нет предметов. Сначала создайте предмет.\n";
                     break;
                 }
@@ -1226,42 +2638,11 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                 break;
             }
             case 5: {
-                vector<SubmissionRecord> professorPending;
-                for (const auto& sub : submissions) {
-                    if (sub.status == "pending") {
-                        auto subject = findSubject(sub.subjectName);
-                        if (subject && subject->isProfessor(professor->getId())) {
-                            professorPending.push_back(sub);
-                        }
-                    }
-                }
+                auto professorPending = getProfessorPendingSubmissions(professor->getId());
                 
-                if (professorPending.empty()) {
+                if (!printPendingList(professorPending)) {
                     cout << "Нет работ на проверку по вашим предметам.\n";
                 } else {
-                    cout << "Работы на проверку по вашим предметам (" << professorPending.size() << "):\n";
-                    for (size_t i = 0; i < professorPending.size(); i++) {
-                        const auto& sub = professorPending[i];
-                        auto student = findStudentById(sub.studentId);
-                        string studentName = student ? student->getName() : "Неизвестный";
-                        
-                        double maxScore = 100.0;
-                        for (const auto& assignment : assignments) {
-                            if (assignment->getName() == sub.assignmentName && 
-                                assignment->getSubjectName() == sub.subjectName) {
-                                maxScore = assignment->getMaxScore();
-                                break;
-                            }
-                        }
-                        
-                        cout << i+1 << ". Студент: " << studentName 
-                                  << " (ID: " << sub.studentId << ")"
-                                  << ", Предмет: " << sub.subjectName 
-                                  << ", Задание: " << sub.assignmentName 
-                                  << " (макс. балл: " << maxScore << ")"
-                                  << " (отправлено: " << sub.timestamp << ")\n";
-                    }
-                    
                     cout << "\nВыберите работу для проверки (номер): ";
                     int workNum;
                     cin >> workNum;
@@ -1269,23 +2650,7 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                     
                     if (workNum > 0 && workNum <= static_cast<int>(professorPending.size())) {
                         auto& sub = professorPending[workNum-1];
-                        auto student = findStudentById(sub.studentId);
-                        string studentName = student ? student->getName() : "Неизвестный";
-                        
-                        cout << "\nВы выбрали работу:\n";
-                        cout << "Студент: " << studentName << " (ID: " << sub.studentId << ")\n";
-                        cout << "Предмет: " << sub.subjectName << endl;
-                        cout << "Задание: " << sub.assignmentName << endl;
-                        
-                        double maxScore = 100.0;
-                        for (const auto& assignment : assignments) {
-                            if (assignment->getName() == sub.assignmentName && 
-                                assignment->getSubjectName() == sub.subjectName) {
-                                maxScore = assignment->getMaxScore();
-                                break;
-                            }
-                        }
-                        cout << "Максимальный балл: " << maxScore << endl;
+                        double maxScore = printSubmissionDetails(sub);
                         
                         cout << "\n1. Утвердить и выставить оценку\n";
                         cout << "2. Отклонить\n";
@@ -1300,19 +2665,10 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                             cin >> grade;
                             cin.ignore();
                             
-                            gradeAssignment(sub.studentId, sub.subjectName, sub.assignmentName, grade);
+                            gradeAssignment(sub.studentId, SymbolTable::name(sub.subjectId),
+                                            SymbolTable::name(sub.itemId), grade);
                         } else if (action == 2) {
-                            for (auto& s : submissions) {
-                                if (s.studentId == sub.studentId && 
-                                    s.subjectName == sub.subjectName && 
-                                    s.assignmentName == sub.assignmentName &&
-                                    s.status == "pending") {
-                                    s.status = "rejected";
-                                    cout << "Работа отклонена. Студент может пересдать.\n";
-                                    saveAllData();
-                                    break;
-                                }
-                            }
+                            rejectSubmission(sub);
                         }
                     } else {
                         cout << "Неверный номер работы!\n";
@@ -1321,37 +2677,13 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                 break;
             }
             case 6: {
-                vector<shared_ptr<Report>> professorReports;
-                for (const auto& report : reports) {
-                    auto subject = findSubject(report->getSubjectName());
-                    if (subject && subject->isProfessor(professor->getId())) {
-                        bool hasGrades = false;
-                        for (const auto& grade : grades) {
-                            if (grade.type == "report" && grade.itemName == report->getTopic()) {
-                                hasGrades = true;
-                                break;
-                            }
-                        }
-                        
-                        if (!hasGrades) {
-                            professorReports.push_back(report);
-                        }
-                    }
-                }
+                auto professorReports = getGradableReports(professor->getId());
                 
-                if (professorReports.empty()) {
+                if (!printGradableReports(professorReports)) {
                     cout << "Нет докладов для оценки по вашим предметам.\n";
                     break;
                 }
                 
-                cout << "Доступные для оценки доклады по вашим предметам:\n";
-                for (size_t i = 0; i < professorReports.size(); i++) {
-                    const auto& report = professorReports[i];
-                    cout << i+1 << ". " << report->getTopic() 
-                              << " (Предмет: " << report->getSubjectName()
-                              << ", Участников: " << report->getSignedUpCount() << ")\n";
-                }
-                
                 cout << "Выберите номер доклада: ";
                 int reportNum;
                 cin >> reportNum;
@@ -1362,21 +2694,11 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                     string subjectName = report->getSubjectName();
                     string reportName = report->getTopic();
                     
-                    auto participants = report->getSignedUpStudents();
-                    
-                    if (participants.empty()) {
+                    if (!printReportParticipants(*report)) {
                         cout << "На этот доклад не записан ни один студент.\n";
                         break;
                     }
                     
-                    cout << "Студенты, записанные на доклад '" << reportName << "':\n";
-                    for (int studentId : participants) {
-                        auto student = findStudentById(studentId);
-                        if (student) {
-                            cout << "- " << student->getName() << " (ID: " << studentId << ")\n";
-                        }
-                    }
-                    
                     cout << "Введите оценку для всех участников (0-100): ";
                     double grade;
                     cin >> grade;
@@ -1389,17 +2711,8 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                 break;
             }
             case 7: {
-                bool hasSubjects = false;
                 cout << "Ваши предметы:\n";
-                for (const auto& subject : subjects) {
-                    if (subject->isProfessor(professor->getId())) {
-                        cout << "- " << subject->getName() 
-                                  << " (код: " << subject->getCode() << ")\n";
-                        hasSubjects = true;
-                    }
-                }
-                
-                if (!hasSubjects) {
+                if (!listProfessorSubjects(professor->getId())) {
                     cout << "У вас нет предметов.\n";
                     break;
                 }
@@ -1417,17 +2730,8 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                 break;
             }
             case 8: {
-                bool hasSubjects = false;
                 cout << "Ваши предметы:\n";
-                for (const auto& subject : subjects) {
-                    if (subject->isProfessor(professor->getId())) {
-                        cout << "- " << subject->getName() 
-                                  << " (код: " << subject->getCode() << ")\n";
-                        hasSubjects = true;
-                    }
-                }
-                
-                if (!hasSubjects) {
+                if (!listProfessorSubjects(professor->getId())) {
                     cout << "У вас нет предметов.\n";
                     break;
                 }
@@ -1438,23 +2742,70 @@ void UniversitySystem::runProfessorMenu(shared_ptr<Professor> professor) {
                 
                 auto subject = findSubjectByNameOrCode(identifier);
                 if (subject && subject->isProfessor(professor->getId())) {
-                    map<int, string> studentNames;
-                    auto enrolledStudents = subject->getEnrolledStudents();
-                    for (int studentId : enrolledStudents) {
-                        auto student = findStudentById(studentId);
-                        if (student) {
-                            studentNames[studentId] = student->getName();
-                        }
-                    }
-                    
-                    subject->generateFinalReport(studentNames);
+                    showFinalReport(*subject);
                 } else {
                     cout << "Предмет не найден или вы не ведете его!\n";
                 }
                 break;
             }
-            case 9:
-                logout();
+            case 9: {
+                cout << "Введите название предмета или код: ";
+                string identifier;
+                getline(cin, identifier);
+                
+                auto subject = findSubjectByNameOrCode(identifier);
+                if (!subject || !subject->isProfessor(professor->getId())) {
+                    cout << "Предмет не найден или вы не ведете его!\n";
+                    break;
+                }
+                
+                listSubjectStudents(*subject);
+                cout << "Введите ID студента: ";
+                int studentId;
+                cin >> studentId;
+                cin.ignore();
+                
+                showStudentRanking(subject->getName(), studentId);
+                break;
+            }
+            case 10: {
+                cout << "Название предмета или код (пусто - по всем предметам): ";
+                string identifier;
+                getline(cin, identifier);
+                cout << "Сколько студентов показать: ";
+                int k;
+                cin >> k;
+                cin.ignore();
+                
+                if (identifier.empty()) {
+                    showLeaderboard(max(k, 0));
+                    break;
+                }
+                auto subject = findSubjectByNameOrCode(identifier);
+                if (subject) {
+                    showLeaderboard(max(k, 0), subject->getName());
+                } else {
+                    cout << "Предмет не найден!\n";
+                }
+                break;
+            }
+            case 11: {
+                cout << "Путь к CSV (студент,предмет,задание,оценка): ";
+                string path;
+                getline(cin, path);
+                importFromFile(path, professor->getId(), &UniversitySystem::importGrades, "Импортировано оценок: ");
+                break;
+            }
+            case 12: {
+                cout << "Путь к списку (имя,пароль[,предмет...]): ";
+                string path;
+                getline(cin, path);
+                importFromFile(path, professor->getId(), &UniversitySystem::importRoster,
+                               "Зарегистрировано студентов: ");
+                break;
+            }
+            case 13:
+                logout(currentUser);
                 saveAllData();
                 return;
             default:
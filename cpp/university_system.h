@@ -1,12 +1,86 @@
+#pragma once
+#include "user.h"
+#include "student.h"
+#include "professor.h"
+#include "object.h"
+#include "data_manager.h"
+#include "symbol_table.h"
+#include "leaderboard.h"
+#include "shard_executor.h"
+#include <map>
+#include <vector>
+#include <memory>
+#include <string>
+#include <set>
+#include <unordered_map>
+
+using namespace std;
+
+struct SubmissionRecord {
+    int studentId;          // ID студента
+    Symbol subjectId;       // Название предмета (SymbolTable)
+    Symbol itemId;          // Название задания или доклада (SymbolTable)
+    string type;            // Тип: "assignment" или "report"
+    string status;          // Статус: "pending", "approved", "rejected"
+    long long timestamp;    // Время сдачи (секунды эпохи)
+};
+
+// Составной ключ сдачи: студент, предмет, задание/доклад, тип
+struct SubmissionKey {
+    int studentId;
+    Symbol subjectId;
+    Symbol itemId;
+    string type;
+    
+    bool operator==(const SubmissionKey& other) const {
+        return studentId == other.studentId && subjectId == other.subjectId &&
+               itemId == other.itemId && type == other.type;
+    }
+};
+
+struct SubmissionKeyHash {
+    size_t operator()(const SubmissionKey& key) const;
 };
 
 struct GradeRecord {
     int studentId;          // ID студента
-    string subjectName;     // Название предмета
-    string itemName;        // Название задания или доклада
+    Symbol subjectId;       // Название предмета (SymbolTable)
+    Symbol itemId;          // Название задания или доклада (SymbolTable)
     string type;            // Тип: "assignment" или "report"
     double score;           // Оценка
-    string timestamp;       // Время выставления
+    long long timestamp;    // Время выставления (секунды эпохи)
+};
+
+// Накопительная статистика предмета, обновляется при каждой сдаче и оценке
+struct SubjectStats {
+    int submitted = 0;        // Сдач заданий (любой статус)
+    int pending = 0;          // Работ на проверке
+    int gradeCount = 0;       // Выставленных оценок
+    double sum = 0;           // Сумма оценок
+    double min = 0;           // Минимальная оценка
+    double max = 0;           // Максимальная оценка
+    double sumSquares = 0;    // Сумма квадратов оценок (для дисперсии)
+    
+    void addScore(double score);  // Учесть новую оценку
+};
+
+// Очередь работ на проверку: (время сдачи, позиция в submissions), старые первыми
+using PendingQueue = set<pair<long long, size_t>>;
+
+// Итог пакетного импорта (оценок или списка студентов)
+struct ImportReport {
+    size_t applied = 0;                      // Применено строк
+    vector<pair<size_t, string>> failures;   // Отклоненные строки: (номер строки, причина)
+    bool saved = true;                       // false - строки применены, но контрольная точка не записана
+};
+
+// Состояние сетевой сессии (режим сервера): вошедший пользователь и последние
+// показанные ему нумерованные списки, по которым клиент выбирает элемент
+struct ClientSession {
+    shared_ptr<User> user;                        // Пользователь сессии (nullptr - не вошел)
+    vector<shared_ptr<Report>> listedReports;     // Последний список докладов (запись или оценка)
+    vector<SubmissionRecord> listedSubmissions;   // Последний список работ на проверку
+    string importBuffer;                          // Строки файла импорта, переданные IMPORT_LINE
 };
 
 class UniversitySystem {
@@ -16,66 +90,224 @@ private:
     map<int, shared_ptr<Professor>> professors; // Преподаватели по ID
     
     vector<shared_ptr<Subject>> subjects;      // Все предметы
+    unordered_map<Symbol, shared_ptr<Subject>> subjectsByName; // Индекс предметов по названию (SymbolTable)
+    unordered_map<string, shared_ptr<Subject>> subjectsByCode; // Индекс предметов по коду
     vector<shared_ptr<Assignment>> assignments; // Все задания
     vector<shared_ptr<Report>> reports;        // Все доклады
     
-    map<int, vector<string>> studentEnrollments; // Записи студентов на предметы
-    map<string, vector<int>> subjectEnrollments; // Записи по предметам
+    map<int, set<Symbol>> studentEnrollments;    // Предметы студента (без повторов)
+    unordered_map<Symbol, set<int>> subjectEnrollments; // Студенты предмета (обратный индекс)
     vector<SubmissionRecord> submissions;        // Все сдачи работ
+    unordered_map<SubmissionKey, vector<size_t>, SubmissionKeyHash> submissionIndex; // Позиции сдач в submissions по ключу
+    unordered_map<Symbol, PendingQueue> pendingBySubject; // Работы на проверке по предметам
+    unordered_map<int, PendingQueue> pendingByProfessor;  // Работы на проверке по преподавателям
     vector<GradeRecord> grades;                  // Все оценки
+    unordered_map<Symbol, SubjectStats> subjectStats; // Статистика по предметам
+    Leaderboard overallLeaderboard;              // Рейтинг студентов по среднему баллу за все предметы
+    unordered_map<Symbol, Leaderboard> subjectLeaderboards; // Рейтинг студентов внутри предмета
+    
+    // Блокировки захватываются в порядке: stateMutex -> Subject::getMutex() -> recordsMutex.
+    // Монопольный stateMutex исключает все остальные операции (новые пользователи,
+    // предметы, записи, доклады); оценка и сдача берут его разделяемо, а предмет - монопольно,
+    // поэтому изменения разных предметов идут параллельно
+    mutable RwLock stateMutex;                   // Состав системы: пользователи, предметы, зачисления
+    mutable RwLock recordsMutex;                 // Общие журналы: сдачи, очереди, оценки, статистика, рейтинги, журнал изменений
     
-    shared_ptr<User> currentUser;                // Текущий авторизованный пользователь
+    NotificationQueue notifications;             // Уведомления об оценках (доставляет фоновый поток)
+    unique_ptr<ShardedExecutor> subjectWorkers;  // Потоки-владельцы предметов (nullptr - режим выключен)
+    
+    shared_ptr<User> currentUser;                // Пользователь локального меню (сессии сервера хранят своего)
+    unsigned dirtyCollections = 0;               // Коллекции, измененные с последнего сохранения (DataCollection)
     
     void loadAllData();                          // Загрузка всех данных при запуске
-    void saveAllData();                          // Сохранение всех данных
+    bool saveAllData();                          // Сохранение всех данных (контрольная точка), false - ошибка записи
+    bool saveAllDataLocked();                    // То же при монопольно захваченном stateMutex
+    void logChange(const string& type, const vector<string>& fields); // Запись изменения в журнал
+    void commitChanges();                        // Завершение мутации: контрольная точка или полное сохранение
+    void markDirty(unsigned collections) { dirtyCollections |= collections; }  // Отметить измененные коллекции
+    static unsigned collectionsForChange(const string& type);  // Какие файлы затрагивает запись журнала
+    bool applyJournalRecord(const JournalRecord& record);             // Повтор записи журнала при загрузке (false - запись повреждена)
     void showMainMenu();                         // Отображение главного меню (до входа)
     
     bool isStudentAlreadyEnrolled(int studentId, const string& subjectName) const; // Проверка двойной записи
+    bool recordEnrollment(int studentId, const string& subjectName);               // Добавить запись в оба индекса (false - уже была)
     shared_ptr<Subject> findSubjectByNameOrCode(const string& identifier) const;   // Поиск по названию или коду
     void removeReport(const string& subjectName, const string& reportName);        // Удаление доклада после оценки
     shared_ptr<Report> findReportForSubject(const string& subjectName, const string& reportName) const;  // Поиск доклада по предмету
     
     shared_ptr<Subject> findSubject(const string& name) const;  // Поиск предмета по имени
+    shared_ptr<Subject> findSubject(Symbol subjectId) const;    // Поиск предмета по номеру названия
+    Symbol subjectKey(const string& identifier) const;          // Ключ владельца предмета по названию или коду
+    // В режиме акторов предмет читает и меняет только его поток-владелец, поэтому
+    // блокировка предмета не берется; без режима ее роль играет Subject::getMutex().
+    // Операцию передают владельцу до захвата любых блокировок: ожидание владельца
+    // с удерживаемым stateMutex при ждущем писателе было бы взаимоблокировкой
+    bool needsOwner(const string& identifier) const;            // Вызывающий поток не владеет предметом
+    unique_lock<RwLock> lockSubject(const Subject& subject) const;  // Монопольно (в режиме акторов - пусто)
+    shared_lock<RwLock> readSubject(const Subject& subject) const;  // Разделяемо (в режиме акторов - пусто)
+    // Записавшихся на доклады и отметки об оценке меняет владелец предмета под его блокировкой.
+    // readOnSubject вызывает read(предмет или nullptr) у владельца под разделяемыми stateMutex
+    // и блокировкой предмета; вызывается без удерживаемых блокировок
+    template <class F>
+    auto readOnSubject(const string& subjectName, F&& read) const -> decltype(read(static_cast<const Subject*>(nullptr)));
+    void indexSubject(const shared_ptr<Subject>& subject);      // Добавить предмет в индексы
+    void rebuildSubjectIndexes();                               // Пересобрать индексы по subjects
     shared_ptr<Report> findReport(const string& topic) const;   // Поиск доклада по теме
     shared_ptr<Student> findStudentById(int id) const;          // Поиск студента по ID
     
+    void addSubmission(const SubmissionRecord& submission);     // Добавить сдачу и проиндексировать ее
+    void rebuildSubmissionIndex();                              // Пересобрать индекс по submissions
+    SubmissionRecord* findSubmission(int studentId, Symbol subjectId, Symbol itemId,  // Первая сдача по ключу
+                                     const string& type,                              // (и статусу, если задан)
+                                     const string& status = "");
+    void setSubmissionStatus(SubmissionRecord* submission, const string& status,  // Сменить статус сдачи
+                             long long timestamp);                                 // с обновлением очередей
+    void enqueuePending(size_t position);                       // Поставить сдачу в очереди на проверку
+    void dequeuePending(size_t position);                       // Убрать сдачу из очередей на проверку
+    void rebuildPendingQueues();                                // Пересобрать очереди по submissions
+    void addGrade(const GradeRecord& grade);                    // Добавить оценку и учесть ее в статистике
+    void rebuildSubjectStatistics();                            // Пересчитать сдачи и оценки в статистике
+    void recordLeaderboardGrade(Symbol subjectId, int studentId,           // Учесть оценку в рейтингах
+                                double previous, double grade);            // (previous < 0 - новая оценка)
+    void rebuildLeaderboards();                                 // Пересобрать рейтинги по журналам предметов
+    void applyAssignmentGrade(Subject& subject, int studentId,   // Выставить проверенную оценку за задание
+                              Symbol assignmentId,               // (journal = false - без записи в журнал,
+                              double grade, bool journal);       // только отметка для контрольной точки)
+    
     void addSubject(shared_ptr<Subject> subject);                // Добавление нового предмета
-    void enrollStudentInSubject(int studentId, const string& identifier); // Запись студента на предмет
-    vector<string> getStudentSubjects(int studentId) const;      // Получение предметов студента
+    void replaceSubjectProfessor(const string& name, const string& code, int professorId); // Смена преподавателя
+    void enrollStudentInSubject(int studentId, const string& identifier,  // Запись студента на предмет
+                                ostream& out = cout);
+    const set<Symbol>& getStudentSubjects(int studentId) const;  // Получение предметов студента (SymbolTable)
     
     void addAssignment(shared_ptr<Assignment> assignment);       // Добавление задания
     void addReport(shared_ptr<Report> report);                   // Добавление доклада
     
-    bool submitAssignment(int studentId, const string& subjectName,  // Сдача задания
-                         const string& assignmentName);
     bool submitReport(int studentId, const string& subjectName,      // Сдача доклада
                      const string& reportName);
     
-    bool gradeAssignment(int studentId, const string& subjectName,   // Оценка за задание
-                        const string& assignmentName, double grade);
-    bool gradeReport(const string& identifier,                       // Оценка за доклад
-                    const string& reportName, double grade);
+    // Команды пишут вывод в out: консоль локального меню или тело ответа сессии сервера
+    void listAllReports() const;                     // Список всех докладов
+    void listAllStudents(ostream& out = cout) const; // Список всех студентов
+    void listAllProfessors() const;                  // Список всех преподавателей
     
-    vector<SubmissionRecord> getPendingSubmissions(const string& subjectName = "") const;  // Работы на проверке
-    
-    void listAllSubjects() const;    // Список всех предметов
-    void listAllReports() const;     // Список всех докладов
-    void listAllStudents() const;    // Список всех студентов
-    void listAllProfessors() const;  // Список всех преподавателей
+    bool listStudentSubjects(int studentId, ostream& out = cout) const;      // Предметы студента (false - их нет)
+    bool listProfessorSubjects(int professorId, ostream& out = cout) const;  // Предметы преподавателя (false - их нет)
+    void listSubjectStudents(const Subject& subject, ostream& out = cout) const;  // Зачисленные на предмет студенты
+    vector<shared_ptr<Report>> getAvailableReports(int studentId,            // Вывести и вернуть доклады для записи
+                                                   ostream& out = cout) const;
+    bool joinReport(int studentId, const shared_ptr<Report>& report,         // Записаться на доклад
+                    ostream& out = cout);
+    bool leaveReport(int studentId, const string& topic, ostream& out = cout);  // Отказаться от доклада
+    void takeOverSubject(int professorId, const shared_ptr<Subject>& existing,  // Стать преподавателем
+                         const string& code, ostream& out = cout);              // существующего предмета
+    void createAssignment(const shared_ptr<Professor>& professor,            // Создать задание
+                          const shared_ptr<Subject>& subject, const string& name, double maxScore,
+                          ostream& out = cout);
+    void createReport(const shared_ptr<Professor>& professor,                // Создать доклад
+                      const shared_ptr<Subject>& subject, const string& topic, int maxParticipants,
+                      ostream& out = cout);
+    bool rejectSubmission(const SubmissionRecord& submission, ostream& out = cout);  // Отклонить работу на проверке
+    vector<shared_ptr<Report>> getGradableReports(int professorId) const;    // Неоцененные доклады преподавателя
+    bool printPendingList(const vector<SubmissionRecord>& pending,           // Нумерованный список работ (false - пуст)
+                          ostream& out = cout) const;
+    double printSubmissionDetails(const SubmissionRecord& sub,               // Карточка работы, вернуть макс. балл
+                                  ostream& out = cout) const;
+    bool printGradableReports(const vector<shared_ptr<Report>>& gradable,    // Нумерованный список докладов
+                              ostream& out = cout) const;
+    bool printReportParticipants(const Report& report, ostream& out = cout) const;  // Участники доклада (false - нет)
+    void showLeaderboard(size_t k, const string& subjectName = "",           // Таблица лучших студентов
+                         ostream& out = cout) const;
+    static vector<string> splitCsvLine(const string& line);                 // Поля строки CSV без пробелов по краям
+    bool importFromFile(const string& path, int professorId,                // Импорт из файла с выводом итога
+                        ImportReport (UniversitySystem::*import)(istream&, int), const string& label);
+    bool importAndReport(istream& input, int professorId,                  // Импорт из потока с выводом итога (false - не сохранен)
+                         ImportReport (UniversitySystem::*import)(istream&, int), const string& label,
+                         ostream& out = cout);
     
-    void showSubjectStatistics(const string& subjectName) const;    // Статистика по предмету
-    void showStudentSubjectSummary(int studentId) const;            // Итоги по предметам для студента
-    
-    bool login(const string& name, const string& password);  // Вход в систему
-    void logout();                                           // Выход из системы
-    bool registerUser(const string& name, const string& password, User::Role role); // Регистрация нового пользователя
+    bool login(const string& name, const string& password,  // Вход в систему: найденный
+               shared_ptr<User>& sessionUser, ostream& out = cout);  // пользователь пишется в sessionUser
+    void logout(shared_ptr<User>& sessionUser, ostream& out = cout);  // Выход из системы
+    bool registerUser(const string& name, const string& password,    // Регистрация нового пользователя
+                      User::Role role, ostream& out = cout);
     
     void runStudentMenu(shared_ptr<Student> student);      // Меню для студента
     void runProfessorMenu(shared_ptr<Professor> professor); // Меню для преподавателя
+    string executeRequest(ClientSession& session,          // Команда протокола от имени session.user,
+                          const vector<string>& request, ostream& out);  // вернуть статус
     
 public:
     UniversitySystem();
     ~UniversitySystem();
     
     void run();                                            // Главный цикл программы
+    string handleRequest(ClientSession& session, const string& request);  // Запрос сессии -> ответ протокола
+    
+    // ПОТОКОБЕЗОПАСНЫЙ ИНТЕРФЕЙС
+    // Чтения идут параллельно друг с другом и с оценками других предметов,
+    // оценки и сдачи сериализуются только внутри своего предмета
+    bool submitAssignment(int studentId, const string& subjectName,  // Сдача задания
+                         const string& assignmentName, ostream& out = cout);
+    bool gradeAssignment(int studentId, const string& subjectName,   // Оценка за задание
+                        const string& assignmentName, double grade, ostream& out = cout);
+    bool gradeReport(const string& identifier,                       // Оценка за доклад
+                    const string& reportName, double grade, ostream& out = cout);
+    // Импорт CSV "студент,предмет,задание,оценка" (студент - ID или имя, предмет - название
+    // или $код). Все строки проверяются до изменений, верные применяются разом и сохраняются
+    // одной контрольной точкой. professorId >= 0 - только предметы этого преподавателя
+    ImportReport importGrades(istream& csv, int professorId = -1);
+    // Импорт списка студентов "имя,пароль[,предмет...]": новые студенты получают
+    // сплошной блок ID, зачисляются на перечисленные предметы (название или $код)
+    // и сохраняются одной контрольной точкой. professorId >= 0 - только его предметы
+    ImportReport importRoster(istream& roster, int professorId = -1);
+    
+    vector<SubmissionRecord> getPendingSubmissions(const string& subjectName = "") const;  // Работы на проверке
+    vector<SubmissionRecord> getProfessorPendingSubmissions(int professorId) const;       // Работы на проверке у преподавателя
+    
+    void listAllSubjects() const;                                    // Список всех предметов
+    void showSubjectStatistics(const string& subjectName, ostream& out = cout) const;  // Статистика по предмету
+    void showStudentSubjectSummary(int studentId, ostream& out = cout) const;          // Итоги по предметам для студента
+    void showStudentRanking(const string& subjectName, int studentId,                  // Место студента и квантили предмета
+                            ostream& out = cout) const;
+    void showFinalReport(const Subject& subject, ostream& out = cout) const;           // Итоговый отчет с именами студентов
+    vector<pair<int, double>> getTopStudents(size_t k, const string& subjectName = "") const;  // Лучшие k: (ID, средний балл)
+    
+    // РЕЖИМ АКТОРОВ ПО ПРЕДМЕТАМ (--subject-workers)
+    // Каждый предмет закреплен за одним рабочим потоком, операции над предметом
+    // (сдача, оценки, новые задания и доклады, статистика и отчеты) выполняются
+    // в его почтовом ящике по очереди и обходятся без блокировки предмета.
+    // Без запущенных потоков runOnSubject выполняет операцию сразу в вызывающем потоке.
+    // Режим включается и выключается, только пока нет других обращений к системе
+    void startSubjectWorkers(size_t workers);    // Запустить владельцев (0 - по числу ядер)
+    void stopSubjectWorkers();                   // Выполнить поставленное и остановить потоки
+    template <class F>
+    auto runOnSubject(const string& identifier, F&& operation) const -> future<decltype(operation())>;
 };
+
+template <class F>
+auto UniversitySystem::runOnSubject(const string& identifier, F&& operation) const -> future<decltype(operation())> {
+    if (!subjectWorkers) {
+        packaged_task<decltype(operation())()> task(forward<F>(operation));
+        auto result = task.get_future();
+        task();
+        return result;
+    }
+    return subjectWorkers->submit(subjectKey(identifier), forward<F>(operation));
+}
+
+template <class F>
+auto UniversitySystem::readOnSubject(const string& subjectName, F&& read) const -> decltype(read(static_cast<const Subject*>(nullptr))) {
+    auto locked = [&] {
+        shared_lock<RwLock> state(stateMutex);
+        auto subject = findSubject(subjectName);
+        shared_lock<RwLock> subjectLock;
+        if (subject) {
+            subjectLock = readSubject(*subject);
+        }
+        return read(static_cast<const Subject*>(subject.get()));
+    };
+    if (needsOwner(subjectName)) {
+        return runOnSubject(subjectName, locked).get();
+    }
+    return locked();
+}
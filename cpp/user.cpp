@@ -18,6 +18,12 @@ User::User(const string& name, const string& passwordHash, int id, Role role)
     }
 }
 
+int User::reserveIds(int count) {
+    int first = nextId;
+    nextId += count;
+    return first;
+}
+
 bool User::checkPassword(const string& password) const {
     return passwordHash == hashPassword(password);
 }
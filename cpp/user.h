@@ -37,4 +37,5 @@ public:
     static string hashPassword(const string& password);
     static void updateNextId(int newNextId) { nextId = newNextId; }
     static int getNextId() { return nextId; }
+    static int reserveIds(int count);                // Выделить сплошной блок из count ID, вернуть первый
 };
\ No newline at end of file